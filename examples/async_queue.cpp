@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <coroutine>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include "async_queue.hpp"
+
+// Single-threaded run queue: resumed coroutines run when run() is called
+struct RunQueue
+{
+    std::deque<std::coroutine_handle<>> ready;
+    std::size_t batches = 0;
+
+    void execute(std::coroutine_handle<> handle)
+    {
+        ready.push_back(handle);
+    }
+
+    void execute_batch(std::coroutine_handle<> *handles, std::size_t count)
+    {
+        batches++;
+        ready.insert(ready.end(), handles, handles + count);
+    }
+
+    void run()
+    {
+        while (!ready.empty())
+        {
+            std::coroutine_handle<> handle = ready.front();
+            ready.pop_front();
+            handle.resume();
+        }
+    }
+};
+
+// Fire-and-forget coroutine that starts eagerly and frees itself when it finishes
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object()
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+Task consumer(queue::AsyncQueue<RunQueue> &queue, int id, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        int value = co_await queue.pop();
+        printf("consumer %d received %d\n", id, value);
+    }
+}
+
+int main()
+{
+    RunQueue executor;
+    queue::AsyncQueue<RunQueue> queue(executor);
+
+    // Every consumer suspends: the queue is empty
+    for (int id = 0; id < 3; id++)
+    {
+        consumer(queue, id, 2);
+    }
+
+    // One bulk push satisfies all three waiters with a single batched wakeup
+    int first[] = {10, 20, 30};
+    queue.push_bulk(first, 3);
+    executor.run();
+
+    // The consumers are waiting again; single pushes wake them one at a time
+    queue.push(40);
+    queue.push(50);
+    queue.push(60);
+    executor.run();
+
+    printf("batched wakeups: %zu, queue is %s\n", executor.batches, queue.is_empty() ? "empty" : "not empty");
+    return 0;
+}
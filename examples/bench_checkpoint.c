@@ -0,0 +1,128 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "queue.h"
+
+#define DEFAULT_ELEMENTS 20000000
+
+static double now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static int temp_file(void)
+{
+    char path[] = "/tmp/bench_checkpoint_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        unlink(path);
+    }
+    return fd;
+}
+
+static void report(const char *method, double start, double end, long elements)
+{
+    double seconds = (end - start) / 1e9;
+    double megabytes = (double)elements * sizeof(int) / 1e6;
+    printf("%-28s%10.3f s%10.1f MB/s of payload\n", method, seconds, megabytes / seconds);
+}
+
+static bool same_contents(struct LinkedList *a, struct LinkedList *b)
+{
+    if (queue_size(a) != queue_size(b))
+    {
+        return false;
+    }
+    for (struct Node *x = a->head, *y = b->head; x != NULL; x = x->next, y = y->next)
+    {
+        if (x->data != y->data)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    long elements = argc > 1 ? atol(argv[1]) : DEFAULT_ELEMENTS;
+    queue_enable_auto_cleanup();
+
+    struct LinkedList *list = queue_create();
+    for (long i = 0; i < elements; i++)
+    {
+        queue_push(list, (int)(i * 2654435761u));
+    }
+    printf("checkpointing a queue of %ld elements\n", elements);
+
+    /* Baseline: one formatted fprintf per element, as queue_print does */
+    int fd = temp_file();
+    FILE *text = fdopen(fd, "w");
+    double start = now_ns();
+    for (struct Node *node = list->head; node != NULL; node = node->next)
+    {
+        fprintf(text, "%d ", node->data);
+    }
+    fflush(text);
+    fsync(fd);
+    double end = now_ns();
+    fclose(text);
+    report("fprintf per element", start, end, elements);
+
+    fd = temp_file();
+    start = now_ns();
+    bool saved = queue_save(list, fd);
+    fsync(fd);
+    end = now_ns();
+    report("queue_save", start, end, elements);
+
+    lseek(fd, 0, SEEK_SET);
+    start = now_ns();
+    struct LinkedList *restored = queue_load(fd);
+    end = now_ns();
+    report("queue_load", start, end, elements);
+    close(fd);
+    printf("round trip %s\n", saved && restored && same_contents(list, restored) ? "ok" : "FAILED");
+
+    /* Save every registered queue and restore them */
+    fd = temp_file();
+    int saved_queues = queue_save_all(fd);
+    lseek(fd, 0, SEEK_SET);
+    struct LinkedList *lists[MAX_QUEUES];
+    int loaded_queues = queue_load_all(fd, lists, MAX_QUEUES);
+    close(fd);
+    printf("queue_save_all/queue_load_all: %d saved, %d restored, %s\n", saved_queues, loaded_queues,
+           loaded_queues == 2 && same_contents(list, lists[0]) && same_contents(restored, lists[1]) ? "ok" : "FAILED");
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "queue.h"
+#include "chunk_queue.h"
+
+#define DEFAULT_ELEMENTS 10000000
+
+static double now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static uint32_t random_state = 12345;
+
+static uint32_t next_random(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static int *generate_ids(long count, int max_gap)
+{
+    /* Mostly increasing IDs with random gaps and occasional small reorderings */
+    int *ids = (int *)malloc((size_t)count * sizeof(int));
+    int id = 100000000;
+    for (long i = 0; i < count; i++)
+    {
+        id += (int)(next_random() % (uint32_t)(max_gap + 1));
+        ids[i] = (next_random() % 16 == 0) ? id - (int)(next_random() % 8) : id;
+    }
+    return ids;
+}
+
+static void bench_codec(const int *ids, long count, int max_gap)
+{
+    long chunks = count / CHUNK_QUEUE_CHUNK_SIZE;
+    uint32_t *encoded = (uint32_t *)malloc((size_t)chunks * CHUNK_CODEC_MAX_WORDS * sizeof(uint32_t));
+    size_t *offsets = (size_t *)malloc((size_t)chunks * sizeof(size_t));
+    int decoded[CHUNK_QUEUE_CHUNK_SIZE];
+
+    size_t words = 0;
+    double start = now_ns();
+    for (long c = 0; c < chunks; c++)
+    {
+        offsets[c] = words;
+        words += chunk_codec_encode(ids + c * CHUNK_QUEUE_CHUNK_SIZE, encoded + words);
+    }
+    double encode_ns = now_ns() - start;
+
+    long mismatches = 0;
+    start = now_ns();
+    for (long c = 0; c < chunks; c++)
+    {
+        chunk_codec_decode(encoded + offsets[c], decoded);
+        mismatches += decoded[c % CHUNK_QUEUE_CHUNK_SIZE] != ids[c * CHUNK_QUEUE_CHUNK_SIZE + c % CHUNK_QUEUE_CHUNK_SIZE];
+    }
+    double decode_ns = now_ns() - start;
+
+    for (long c = 0; c < chunks; c++)
+    {
+        chunk_codec_decode(encoded + offsets[c], decoded);
+        mismatches += memcmp(decoded, ids + c * CHUNK_QUEUE_CHUNK_SIZE, sizeof(decoded)) != 0;
+    }
+
+    long values = chunks * CHUNK_QUEUE_CHUNK_SIZE;
+    printf("gap 0..%-5d %8.2f bits/elem %10.0f M elem/s encode %10.0f M elem/s decode%s\n", max_gap,
+           (double)words * 32.0 / (double)values, (double)values / encode_ns * 1e3, (double)values / decode_ns * 1e3,
+           mismatches ? "  MISMATCH" : "");
+    free(encoded);
+    free(offsets);
+}
+
+static void bench_queue(const char *name, enum ChunkQueueMode mode, const int *ids, long count)
+{
+    struct ChunkQueue *queue = chunk_queue_create(mode);
+    double start = now_ns();
+    for (long i = 0; i < count; i++)
+    {
+        chunk_queue_push(queue, ids[i]);
+    }
+    double push_ns = now_ns() - start;
+    size_t bytes = chunk_queue_memory_usage(queue);
+
+    long mismatches = 0;
+    int value = 0;
+    start = now_ns();
+    for (long i = 0; i < count; i++)
+    {
+        chunk_queue_pop(queue, &value);
+        mismatches += value != ids[i];
+    }
+    double pop_ns = now_ns() - start;
+    printf("%-26s%8.2f bytes/elem %8.2f ns/push %8.2f ns/pop%s\n", name, (double)bytes / (double)count,
+           push_ns / (double)count, pop_ns / (double)count, mismatches ? "  MISMATCH" : "");
+    chunk_queue_free(queue);
+}
+
+static void bench_linked_list(const int *ids, long count)
+{
+    struct LinkedList *list = queue_create();
+    double start = now_ns();
+    for (long i = 0; i < count; i++)
+    {
+        queue_push(list, ids[i]);
+    }
+    double push_ns = now_ns() - start;
+    start = now_ns();
+    for (long i = 0; i < count; i++)
+    {
+        queue_pop(list);
+    }
+    double pop_ns = now_ns() - start;
+    printf("%-26s%8.2f bytes/elem %8.2f ns/push %8.2f ns/pop\n", "LinkedList", (double)sizeof(struct Node),
+           push_ns / (double)count, pop_ns / (double)count);
+}
+
+int main(int argc, char **argv)
+{
+    long count = argc > 1 ? atol(argv[1]) : DEFAULT_ELEMENTS;
+    count = count / CHUNK_QUEUE_CHUNK_SIZE * CHUNK_QUEUE_CHUNK_SIZE;
+    queue_enable_auto_cleanup();
+    printf("%ld nearly increasing IDs\n", count);
+
+    const int gaps[] = {0, 3, 15, 255, 65535};
+    for (size_t g = 0; g < sizeof(gaps) / sizeof(gaps[0]); g++)
+    {
+        int *ids = generate_ids(count, gaps[g]);
+        bench_codec(ids, count, gaps[g]);
+        free(ids);
+    }
+
+    int *ids = generate_ids(count, 15);
+    printf("\nqueues holding %ld IDs with gaps 0..15\n", count);
+    bench_linked_list(ids, count);
+    bench_queue("chunk_queue (plain)", CHUNK_QUEUE_PLAIN, ids, count);
+    bench_queue("chunk_queue (compressed)", CHUNK_QUEUE_COMPRESSED, ids, count);
+    free(ids);
+    return 0;
+}
@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include "queue.h"
+#include "ms_queue.h"
+#include "seg_queue.h"
+#include "fc_queue.h"
+#include "elim_stack.h"
+#include "thread_slot.h"
+
+#define DEFAULT_THREADS 8
+#define DEFAULT_OPS_PER_THREAD 200000
+
+/* Each backend is driven through push/pop wrappers and reports its contention counters */
+struct Backend
+{
+    const char *name;
+    void *(*create)(void);
+    void (*push)(void *queue, int data);
+    bool (*pop)(void *queue, int *out_value);
+    bool (*contention)(void *queue, int thread_slot, struct ContentionStats *out);
+    void (*destroy)(void *queue);
+};
+
+static void *ms_create(void)
+{
+    return ms_queue_create(MS_QUEUE_RECLAIM_HAZARD);
+}
+
+static void ms_push(void *queue, int data)
+{
+    ms_queue_push(queue, data);
+}
+
+static bool ms_pop(void *queue, int *out_value)
+{
+    return ms_queue_pop(queue, out_value);
+}
+
+static bool ms_contention(void *queue, int thread_slot, struct ContentionStats *out)
+{
+    return ms_queue_get_contention(queue, thread_slot, out);
+}
+
+static void ms_destroy(void *queue)
+{
+    ms_queue_free(queue);
+}
+
+static void *seg_create(void)
+{
+    return seg_queue_create();
+}
+
+static void seg_push(void *queue, int data)
+{
+    seg_queue_push(queue, data);
+}
+
+static bool seg_pop(void *queue, int *out_value)
+{
+    return seg_queue_pop(queue, out_value);
+}
+
+static bool seg_contention(void *queue, int thread_slot, struct ContentionStats *out)
+{
+    return seg_queue_get_contention(queue, thread_slot, out);
+}
+
+static void seg_destroy(void *queue)
+{
+    seg_queue_free(queue);
+}
+
+struct CombinedQueue
+{
+    struct FCQueue *fc;
+    struct LinkedList *list;
+};
+
+static void *fc_create(void)
+{
+    struct CombinedQueue *queue = malloc(sizeof(struct CombinedQueue));
+    queue->list = queue_create();
+    queue->fc = fc_queue_create(queue->list, &linked_list_ops);
+    return queue;
+}
+
+static void fc_push(void *queue, int data)
+{
+    fc_queue_push(((struct CombinedQueue *)queue)->fc, data);
+}
+
+static bool fc_pop(void *queue, int *out_value)
+{
+    return fc_queue_pop(((struct CombinedQueue *)queue)->fc, out_value);
+}
+
+static bool fc_contention(void *queue, int thread_slot, struct ContentionStats *out)
+{
+    return fc_queue_get_contention(((struct CombinedQueue *)queue)->fc, thread_slot, out);
+}
+
+static void fc_destroy(void *queue)
+{
+    struct CombinedQueue *combined_queue = queue;
+    fc_queue_free(combined_queue->fc);
+    if (!queue_is_empty(combined_queue->list))
+    {
+        queue_free(combined_queue->list);
+    }
+    free(combined_queue);
+}
+
+static void *elim_create(void)
+{
+    return elim_stack_create(ELIM_STACK_DEFAULT_WIDTH);
+}
+
+static void elim_push(void *queue, int data)
+{
+    elim_stack_push(queue, data);
+}
+
+static bool elim_pop(void *queue, int *out_value)
+{
+    return elim_stack_pop(queue, out_value);
+}
+
+static bool elim_contention(void *queue, int thread_slot, struct ContentionStats *out)
+{
+    return elim_stack_get_contention(queue, thread_slot, out);
+}
+
+static void elim_destroy(void *queue)
+{
+    elim_stack_free(queue);
+}
+
+static const struct Backend backends[] = {
+    {"ms_queue/hazard", ms_create, ms_push, ms_pop, ms_contention, ms_destroy},
+    {"seg_queue", seg_create, seg_push, seg_pop, seg_contention, seg_destroy},
+    {"fc+LinkedList", fc_create, fc_push, fc_pop, fc_contention, fc_destroy},
+    {"elim_stack", elim_create, elim_push, elim_pop, elim_contention, elim_destroy},
+};
+
+struct Worker
+{
+    const struct Backend *backend;
+    void *queue;
+    pthread_barrier_t *barrier;
+    long ops;
+    int slot;
+};
+
+static void *worker_run(void *arg)
+{
+    struct Worker *worker = arg;
+    int value;
+    worker->slot = queue_thread_slot();
+    pthread_barrier_wait(worker->barrier);
+    for (long i = 0; i < worker->ops; i++)
+    {
+        worker->backend->push(worker->queue, (int)i);
+        worker->backend->pop(worker->queue, &value);
+    }
+    return NULL;
+}
+
+static void print_row(const char *label, const struct ContentionStats *stats, long ops)
+{
+    printf("  %-10s%14llu%14llu%10llu%10llu%10llu%14llu%12.3f\n", label, (unsigned long long)stats->cas_failures,
+           (unsigned long long)stats->spins, (unsigned long long)stats->yields, (unsigned long long)stats->parks,
+           (unsigned long long)stats->full_stalls, (unsigned long long)stats->empty_stalls,
+           (double)stats->cas_failures / (double)ops);
+}
+
+static bool run_backend(const struct Backend *backend, int threads, long ops)
+{
+    void *queue = backend->create();
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, (unsigned)threads);
+
+    pthread_t *ids = malloc((size_t)threads * sizeof(pthread_t));
+    struct Worker *workers = malloc((size_t)threads * sizeof(struct Worker));
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i] = (struct Worker){.backend = backend, .queue = queue, .barrier = &barrier, .ops = ops};
+        pthread_create(&ids[i], NULL, worker_run, &workers[i]);
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(ids[i], NULL);
+    }
+
+    struct ContentionStats stats;
+    bool profiled = backend->contention(queue, -1, &stats);
+    if (profiled)
+    {
+        printf("%s\n  %-10s%14s%14s%10s%10s%10s%14s%12s\n", backend->name, "thread", "cas_failures", "spins", "yields",
+               "parks", "full", "empty", "cas/op");
+        for (int i = 0; i < threads; i++)
+        {
+            char label[16];
+            struct ContentionStats thread_stats;
+            snprintf(label, sizeof(label), "%d", i);
+            backend->contention(queue, workers[i].slot, &thread_stats);
+            print_row(label, &thread_stats, ops * 2);
+        }
+        print_row("total", &stats, (long)threads * ops * 2);
+    }
+
+    pthread_barrier_destroy(&barrier);
+    free(workers);
+    free(ids);
+    backend->destroy(queue);
+    return profiled;
+}
+
+int main(int argc, char **argv)
+{
+    int threads = argc > 1 ? atoi(argv[1]) : DEFAULT_THREADS;
+    long ops = argc > 2 ? atol(argv[2]) : DEFAULT_OPS_PER_THREAD;
+
+    printf("%d threads, %ld push/pop pairs per thread\n", threads, ops);
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++)
+    {
+        if (!run_backend(&backends[b], threads, ops))
+        {
+            printf("contention profiling is compiled out; rebuild the library with `make contention`\n");
+            return 0;
+        }
+    }
+    return 0;
+}
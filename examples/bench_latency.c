@@ -0,0 +1,583 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "queue.h"
+#include "ms_queue.h"
+#include "seg_queue.h"
+#include "fc_queue.h"
+#include "affinity.h"
+
+#define DEFAULT_MESSAGES 100000
+#define DEFAULT_RATE 100000
+#define WARMUP_MESSAGES 1000
+#define SLEEP_WAIT_NS 1000
+
+/* Log-linear histogram: values below 2^HIST_SUB_BITS are exact, larger ones keep HIST_SUB_BITS - 1 bits (< 0.8% error) */
+#define HIST_SUB_BITS 8
+#define HIST_HALF (1 << (HIST_SUB_BITS - 1))
+#define HIST_BUCKETS ((64 - HIST_SUB_BITS + 1) * HIST_HALF + HIST_HALF)
+
+struct Histogram
+{
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t total;
+    uint64_t max;
+    double sum;
+    double sum_squares;
+};
+
+static int hist_index(uint64_t value)
+{
+    if (value < (1u << HIST_SUB_BITS))
+    {
+        return (int)value;
+    }
+    int shift = (63 - __builtin_clzll(value)) - HIST_SUB_BITS + 1;
+    return shift * HIST_HALF + (int)(value >> shift);
+}
+
+static uint64_t hist_value(int index)
+{
+    /* Highest value that maps to the bucket, as HdrHistogram reports it */
+    if (index < (1 << HIST_SUB_BITS))
+    {
+        return (uint64_t)index;
+    }
+    int shift = index / HIST_HALF - 1;
+    uint64_t sub = (uint64_t)(index - shift * HIST_HALF);
+    return ((sub + 1) << shift) - 1;
+}
+
+static void hist_record(struct Histogram *hist, uint64_t value)
+{
+    hist->counts[hist_index(value)]++;
+    hist->total++;
+    hist->max = value > hist->max ? value : hist->max;
+    hist->sum += (double)value;
+    hist->sum_squares += (double)value * (double)value;
+}
+
+static uint64_t hist_percentile(const struct Histogram *hist, double percentile)
+{
+    uint64_t target = (uint64_t)ceil(percentile / 100.0 * (double)hist->total);
+    target = target ? target : 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++)
+    {
+        seen += hist->counts[i];
+        if (seen >= target)
+        {
+            uint64_t value = hist_value(i);
+            return value < hist->max ? value : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+/* Percentile distribution in the HdrHistogram text format (values in µs), readable by its plotter */
+static void hist_print_distribution(const struct Histogram *hist)
+{
+    const int ticks_per_half = 5;
+    printf("%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    for (int level = 0; level < 24; level++)
+    {
+        double low = 100.0 - 100.0 / (double)(1 << level);
+        double step = 100.0 / (double)(1 << (level + 1)) / ticks_per_half;
+        for (int tick = 0; tick < ticks_per_half; tick++)
+        {
+            double percentile = low + step * tick;
+            uint64_t value = hist_percentile(hist, percentile);
+            uint64_t count = (uint64_t)ceil(percentile / 100.0 * (double)hist->total);
+            printf("%12.3f %14.12f %10llu %14.2f\n", value / 1000.0, percentile / 100.0, (unsigned long long)count,
+                   1.0 / (1.0 - percentile / 100.0));
+            if (value == hist->max)
+            {
+                level = 24;
+                break;
+            }
+        }
+    }
+    printf("%12.3f %14.12f %10llu\n", hist->max / 1000.0, 1.0, (unsigned long long)hist->total);
+    double mean = hist->total ? hist->sum / (double)hist->total : 0.0;
+    double variance = hist->total ? hist->sum_squares / (double)hist->total - mean * mean : 0.0;
+    printf("#[Mean    = %12.3f, StdDeviation   = %12.3f]\n", mean / 1000.0, sqrt(variance > 0 ? variance : 0) / 1000.0);
+    printf("#[Max     = %12.3f, Total count    = %12llu]\n", hist->max / 1000.0, (unsigned long long)hist->total);
+    printf("#[Buckets = %12d, SubBuckets     = %12d]\n\n", HIST_BUCKETS, 1 << HIST_SUB_BITS);
+}
+
+/* TSC ticks per nanosecond, calibrated against CLOCK_MONOTONIC at startup */
+static double ticks_per_ns = 1.0;
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static inline uint64_t ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int aux;
+    return __rdtscp(&aux);
+#else
+    return now_ns();
+#endif
+}
+
+static inline void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static void calibrate_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t start_ns = now_ns();
+    uint64_t start_ticks = ticks();
+    while (now_ns() - start_ns < 50000000ULL)
+    {
+        cpu_relax();
+    }
+    ticks_per_ns = (double)(ticks() - start_ticks) / (double)(now_ns() - start_ns);
+#endif
+}
+
+static uint64_t ticks_to_ns(uint64_t delta)
+{
+    return (uint64_t)((double)delta / ticks_per_ns);
+}
+
+struct Backend
+{
+    const char *name;
+    void *(*create)(void);
+    void (*push)(void *queue, int data);
+    bool (*pop)(void *queue, int *out_value);
+    void (*destroy)(void *queue);
+};
+
+struct MutexQueue
+{
+    pthread_mutex_t lock;
+    struct LinkedList *list;
+};
+
+static void *mutex_create(void)
+{
+    struct MutexQueue *queue = malloc(sizeof(struct MutexQueue));
+    pthread_mutex_init(&queue->lock, NULL);
+    queue->list = queue_create();
+    return queue;
+}
+
+static void mutex_push(void *queue, int data)
+{
+    struct MutexQueue *mutex_queue = queue;
+    pthread_mutex_lock(&mutex_queue->lock);
+    queue_push(mutex_queue->list, data);
+    pthread_mutex_unlock(&mutex_queue->lock);
+}
+
+static bool mutex_pop(void *queue, int *out_value)
+{
+    struct MutexQueue *mutex_queue = queue;
+    pthread_mutex_lock(&mutex_queue->lock);
+    bool found = !queue_is_empty(mutex_queue->list);
+    if (found)
+    {
+        *out_value = queue_pop(mutex_queue->list);
+    }
+    pthread_mutex_unlock(&mutex_queue->lock);
+    return found;
+}
+
+static void mutex_destroy(void *queue)
+{
+    struct MutexQueue *mutex_queue = queue;
+    if (!queue_is_empty(mutex_queue->list))
+    {
+        queue_free(mutex_queue->list);
+    }
+    pthread_mutex_destroy(&mutex_queue->lock);
+    free(mutex_queue);
+}
+
+static void *ms_hazard_create(void)
+{
+    return ms_queue_create(MS_QUEUE_RECLAIM_HAZARD);
+}
+
+static void *ms_epoch_create(void)
+{
+    return ms_queue_create(MS_QUEUE_RECLAIM_EPOCH);
+}
+
+static void ms_push(void *queue, int data)
+{
+    ms_queue_push(queue, data);
+}
+
+static bool ms_pop(void *queue, int *out_value)
+{
+    return ms_queue_pop(queue, out_value);
+}
+
+static void ms_destroy(void *queue)
+{
+    ms_queue_free(queue);
+}
+
+static void *seg_create(void)
+{
+    return seg_queue_create();
+}
+
+static void seg_push(void *queue, int data)
+{
+    seg_queue_push(queue, data);
+}
+
+static bool seg_pop(void *queue, int *out_value)
+{
+    return seg_queue_pop(queue, out_value);
+}
+
+static void seg_destroy(void *queue)
+{
+    seg_queue_free(queue);
+}
+
+struct CombinedQueue
+{
+    struct FCQueue *fc;
+    struct LinkedList *list;
+};
+
+static void *fc_create(void)
+{
+    struct CombinedQueue *queue = malloc(sizeof(struct CombinedQueue));
+    queue->list = queue_create();
+    queue->fc = fc_queue_create(queue->list, &linked_list_ops);
+    return queue;
+}
+
+static void fc_push(void *queue, int data)
+{
+    fc_queue_push(((struct CombinedQueue *)queue)->fc, data);
+}
+
+static bool fc_pop(void *queue, int *out_value)
+{
+    return fc_queue_pop(((struct CombinedQueue *)queue)->fc, out_value);
+}
+
+static void fc_destroy(void *queue)
+{
+    struct CombinedQueue *combined_queue = queue;
+    fc_queue_free(combined_queue->fc);
+    if (!queue_is_empty(combined_queue->list))
+    {
+        queue_free(combined_queue->list);
+    }
+    free(combined_queue);
+}
+
+static const struct Backend backends[] = {
+    {"mutex+LinkedList", mutex_create, mutex_push, mutex_pop, mutex_destroy},
+    {"ms_queue/hazard", ms_hazard_create, ms_push, ms_pop, ms_destroy},
+    {"ms_queue/epoch", ms_epoch_create, ms_push, ms_pop, ms_destroy},
+    {"seg_queue", seg_create, seg_push, seg_pop, seg_destroy},
+    {"fc+LinkedList", fc_create, fc_push, fc_pop, fc_destroy},
+};
+
+/* How a consumer waits while the queue is empty */
+enum WaitStrategy
+{
+    WAIT_SPIN,
+    WAIT_YIELD,
+    WAIT_SLEEP,
+};
+
+static const char *wait_names[] = {"spin", "yield", "sleep"};
+
+static int wait_pop(const struct Backend *backend, void *queue, enum WaitStrategy wait)
+{
+    int value;
+    while (!backend->pop(queue, &value))
+    {
+        if (wait == WAIT_SPIN)
+        {
+            cpu_relax();
+        }
+        else if (wait == WAIT_YIELD)
+        {
+            sched_yield();
+        }
+        else
+        {
+            struct timespec delay = {0, SLEEP_WAIT_NS};
+            nanosleep(&delay, NULL);
+        }
+    }
+    return value;
+}
+
+struct Run
+{
+    const struct Backend *backend;
+    enum WaitStrategy wait;
+    void *forward;
+    void *back;
+    long messages;
+    bool shared_cpu;
+    uint64_t start_ticks;
+    uint64_t interval_ticks;
+    uint64_t *sent_ticks;
+    struct Histogram *corrected;
+    struct Histogram *uncorrected;
+};
+
+/* Ping-pong: echo every message from `forward` back into `back`; the echo thread is the consumer of `forward` */
+static void *echo_run(void *arg)
+{
+    struct Run *run = arg;
+    affinity_register_consumer(run->forward);
+    for (long i = 0; i < run->messages + WARMUP_MESSAGES; i++)
+    {
+        run->backend->push(run->back, wait_pop(run->backend, run->forward, run->wait));
+    }
+    return NULL;
+}
+
+static void ping_pong(struct Run *run)
+{
+    pthread_t echo;
+    affinity_register_producer(run->forward);
+    pthread_create(&echo, NULL, echo_run, run);
+    for (long i = 0; i < run->messages + WARMUP_MESSAGES; i++)
+    {
+        uint64_t start = ticks();
+        run->backend->push(run->forward, (int)i);
+        wait_pop(run->backend, run->back, run->wait);
+        if (i >= WARMUP_MESSAGES)
+        {
+            hist_record(run->corrected, ticks_to_ns(ticks() - start));
+        }
+    }
+    pthread_join(echo, NULL);
+}
+
+/* Open loop: message i is due at start + i * interval whether or not earlier ones were consumed */
+static void *producer_run(void *arg)
+{
+    struct Run *run = arg;
+    affinity_register_producer(run->forward);
+    for (long i = 0; i < run->messages; i++)
+    {
+        uint64_t due = run->start_ticks + (uint64_t)i * run->interval_ticks;
+        while (ticks() < due)
+        {
+            /* On a shared CPU a spinning producer would only let the consumer run when preempted */
+            if (run->shared_cpu)
+            {
+                sched_yield();
+            }
+            else
+            {
+                cpu_relax();
+            }
+        }
+        run->sent_ticks[i] = ticks();
+        run->backend->push(run->forward, (int)i);
+    }
+    return NULL;
+}
+
+static void open_loop(struct Run *run)
+{
+    pthread_t producer;
+    affinity_register_consumer(run->forward);
+    pthread_create(&producer, NULL, producer_run, run);
+    for (long i = 0; i < run->messages; i++)
+    {
+        int message = wait_pop(run->backend, run->forward, run->wait);
+        uint64_t now = ticks();
+        uint64_t due = run->start_ticks + (uint64_t)message * run->interval_ticks;
+        hist_record(run->corrected, ticks_to_ns(now - due));
+        hist_record(run->uncorrected, ticks_to_ns(now - run->sent_ticks[message]));
+    }
+    pthread_join(producer, NULL);
+}
+
+static void print_row(const char *placement, const char *backend, const char *wait, const char *measure,
+                      const struct Histogram *hist, bool full)
+{
+    printf("%-14s%-18s%-7s%-13s%10.2f%10.2f%10.2f%10.2f%10.2f%10.2f\n", placement, backend, wait, measure,
+           hist_percentile(hist, 50.0) / 1000.0, hist_percentile(hist, 90.0) / 1000.0,
+           hist_percentile(hist, 99.0) / 1000.0, hist_percentile(hist, 99.9) / 1000.0,
+           hist_percentile(hist, 99.99) / 1000.0, hist->max / 1000.0);
+    if (full)
+    {
+        hist_print_distribution(hist);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long messages = DEFAULT_MESSAGES;
+    long rate = DEFAULT_RATE;
+    bool full = false;
+    int only_placement = -1;
+    int positional = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--hdr") == 0)
+        {
+            full = true;
+        }
+        else if (strcmp(argv[i], "--placement") == 0 && i + 1 < argc)
+        {
+            i++;
+            for (int p = 0; p < AFFINITY_PLACEMENTS; p++)
+            {
+                if (strcmp(argv[i], affinity_placement_name((enum AffinityPlacement)p)) == 0)
+                {
+                    only_placement = p;
+                }
+            }
+            if (only_placement < 0)
+            {
+                messages = 0;
+            }
+        }
+        else if (positional++ == 0)
+        {
+            messages = atol(argv[i]);
+        }
+        else
+        {
+            rate = atol(argv[i]);
+        }
+    }
+
+    if (messages <= 0 || rate <= 0)
+    {
+        fprintf(stderr, "usage: %s [messages] [rate_per_sec] [--hdr] [--placement same-cpu|smt-sibling|same-llc|cross-llc|cross-socket]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    queue_enable_auto_cleanup();
+    calibrate_ticks();
+    affinity_print_topology(stdout);
+    printf("%ld messages per case, open-loop rate %ld/s, %.3f ticks/ns\n", messages, rate, ticks_per_ns);
+    for (int p = 0; p < AFFINITY_PLACEMENTS; p++)
+    {
+        int producer_cpu;
+        int consumer_cpu;
+        if (only_placement >= 0 && p != only_placement)
+        {
+            continue;
+        }
+        if (affinity_find_pair((enum AffinityPlacement)p, &producer_cpu, &consumer_cpu))
+        {
+            printf("%-14sproducer on CPU %d, consumer on CPU %d%s\n", affinity_placement_name((enum AffinityPlacement)p),
+                   producer_cpu, consumer_cpu, producer_cpu == consumer_cpu ? " (spin cases skipped)" : "");
+        }
+        else
+        {
+            printf("%-14sskipped: no such pair of CPUs on this host\n", affinity_placement_name((enum AffinityPlacement)p));
+        }
+    }
+    printf("ping-pong reports round trips; open-loop reports push-to-pop latency, corrected for coordinated omission\n");
+    printf("\n%-14s%-18s%-7s%-13s%10s%10s%10s%10s%10s%10s   (µs)\n", "placement", "backend", "wait", "measure", "p50",
+           "p90", "p99", "p99.9", "p99.99", "max");
+
+    struct Histogram *corrected = malloc(sizeof(struct Histogram));
+    struct Histogram *uncorrected = malloc(sizeof(struct Histogram));
+    uint64_t *sent_ticks = malloc((size_t)messages * sizeof(uint64_t));
+    for (int p = 0; p < AFFINITY_PLACEMENTS; p++)
+    {
+        enum AffinityPlacement placement = (enum AffinityPlacement)p;
+        const char *name = affinity_placement_name(placement);
+        int producer_cpu;
+        int consumer_cpu;
+        if ((only_placement >= 0 && p != only_placement) ||
+            !affinity_find_pair(placement, &producer_cpu, &consumer_cpu))
+        {
+            continue;
+        }
+        /* Two spinning threads on one CPU only progress when the scheduler preempts one of them */
+        bool shared_cpu = producer_cpu == consumer_cpu;
+        for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++)
+        {
+            for (int w = shared_cpu ? WAIT_YIELD : WAIT_SPIN; w <= WAIT_SLEEP; w++)
+            {
+                struct Run run = {.backend = &backends[b], .wait = (enum WaitStrategy)w, .messages = messages,
+                                  .shared_cpu = shared_cpu, .sent_ticks = sent_ticks, .corrected = corrected, .uncorrected = uncorrected};
+                run.forward = backends[b].create();
+                run.back = backends[b].create();
+                affinity_set_policy(run.forward, placement);
+
+                memset(corrected, 0, sizeof(struct Histogram));
+                ping_pong(&run);
+                print_row(name, backends[b].name, wait_names[w], "round trip", corrected, full);
+
+                memset(corrected, 0, sizeof(struct Histogram));
+                memset(uncorrected, 0, sizeof(struct Histogram));
+                run.interval_ticks = (uint64_t)(1e9 / (double)rate * ticks_per_ns);
+                run.start_ticks = ticks() + (uint64_t)(1e6 * ticks_per_ns);
+                open_loop(&run);
+                print_row(name, backends[b].name, wait_names[w], "open loop", corrected, full);
+                print_row(name, backends[b].name, wait_names[w], "uncorrected", uncorrected, full);
+
+                affinity_unregister(run.forward);
+                backends[b].destroy(run.forward);
+                backends[b].destroy(run.back);
+            }
+        }
+    }
+    free(sent_ticks);
+    free(uncorrected);
+    free(corrected);
+    return 0;
+}
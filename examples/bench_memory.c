@@ -0,0 +1,274 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <malloc.h>
+#include <unistd.h>
+#include "queue.h"
+#include "ms_queue.h"
+#include "seg_queue.h"
+#include "elim_stack.h"
+#include "chunk_queue.h"
+#include "queue_define.h"
+
+#define DEFAULT_MAX_DEPTH 100000000L
+
+QUEUE_DEFINE(int_ring, int, QUEUE_GROWABLE)
+
+/* Each backend is filled to a depth and asked for the bytes it holds, if it can tell */
+struct Backend
+{
+    const char *name;
+    void *(*create)(void);
+    void (*push)(void *queue, int data);
+    size_t (*memory_usage)(void *queue);
+    void (*destroy)(void *queue);
+};
+
+static void *list_create(void)
+{
+    return queue_create();
+}
+
+static void list_push(void *queue, int data)
+{
+    queue_push(queue, data);
+}
+
+static size_t list_memory_usage(void *queue)
+{
+    return queue_memory_usage(queue);
+}
+
+static void list_destroy(void *queue)
+{
+    if (!queue_is_empty(queue))
+    {
+        queue_free(queue);
+    }
+}
+
+static void *ms_create(void)
+{
+    return ms_queue_create(MS_QUEUE_RECLAIM_HAZARD);
+}
+
+static void ms_push(void *queue, int data)
+{
+    ms_queue_push(queue, data);
+}
+
+static void ms_destroy(void *queue)
+{
+    ms_queue_free(queue);
+}
+
+static void *seg_create(void)
+{
+    return seg_queue_create();
+}
+
+static void seg_push(void *queue, int data)
+{
+    seg_queue_push(queue, data);
+}
+
+static void seg_destroy(void *queue)
+{
+    seg_queue_free(queue);
+}
+
+static void *elim_create(void)
+{
+    return elim_stack_create(ELIM_STACK_DEFAULT_WIDTH);
+}
+
+static void elim_push(void *queue, int data)
+{
+    elim_stack_push(queue, data);
+}
+
+static void elim_destroy(void *queue)
+{
+    elim_stack_free(queue);
+}
+
+static void *chunk_plain_create(void)
+{
+    return chunk_queue_create(CHUNK_QUEUE_PLAIN);
+}
+
+static void *chunk_compressed_create(void)
+{
+    return chunk_queue_create(CHUNK_QUEUE_COMPRESSED);
+}
+
+static void chunk_push(void *queue, int data)
+{
+    chunk_queue_push(queue, data);
+}
+
+static size_t chunk_memory_usage(void *queue)
+{
+    return chunk_queue_memory_usage(queue);
+}
+
+static void chunk_destroy(void *queue)
+{
+    chunk_queue_free(queue);
+}
+
+static void *ring_create(void)
+{
+    struct int_ring *ring = malloc(sizeof(struct int_ring));
+    int_ring_init(ring);
+    return ring;
+}
+
+static void ring_push(void *queue, int data)
+{
+    if (!int_ring_push(queue, data))
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for int_ring.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void ring_destroy(void *queue)
+{
+    int_ring_destroy(queue);
+    free(queue);
+}
+
+static const struct Backend backends[] = {
+    {"LinkedList", list_create, list_push, list_memory_usage, list_destroy},
+    {"ms_queue", ms_create, ms_push, NULL, ms_destroy},
+    {"seg_queue", seg_create, seg_push, NULL, seg_destroy},
+    {"elim_stack", elim_create, elim_push, NULL, elim_destroy},
+    {"QUEUE_DEFINE ring", ring_create, ring_push, NULL, ring_destroy},
+    {"chunk_queue", chunk_plain_create, chunk_push, chunk_memory_usage, chunk_destroy},
+    {"chunk_queue/comp", chunk_compressed_create, chunk_push, chunk_memory_usage, chunk_destroy},
+};
+
+/* Bytes the allocator has handed out, including its chunk headers and mmapped blocks */
+static size_t heap_in_use(void)
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static size_t resident_bytes(void)
+{
+    long pages = 0;
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm)
+    {
+        if (fscanf(statm, "%*s %ld", &pages) != 1)
+        {
+            pages = 0;
+        }
+        fclose(statm);
+    }
+    return (size_t)pages * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static size_t available_bytes(void)
+{
+    long kilobytes = 0;
+    char line[128];
+    FILE *meminfo = fopen("/proc/meminfo", "r");
+    while (meminfo && fgets(line, sizeof(line), meminfo))
+    {
+        if (sscanf(line, "MemAvailable: %ld kB", &kilobytes) == 1)
+        {
+            break;
+        }
+    }
+    if (meminfo)
+    {
+        fclose(meminfo);
+    }
+    return (size_t)kilobytes * 1024;
+}
+
+static void run_backend(const struct Backend *backend, long max_depth)
+{
+    double bytes_per_element = 64.0;
+    printf("%s\n  %12s%16s%16s%16s%10s%10s%10s\n", backend->name, "depth", "api bytes", "heap bytes", "rss bytes",
+           "api/elem", "heap/elem", "rss/elem");
+    for (long depth = 1; depth <= max_depth; depth *= 10)
+    {
+        /* Growable buffers may double while filling, so leave room for twice the last estimate */
+        if (2.0 * bytes_per_element * (double)depth > (double)available_bytes() / 2)
+        {
+            printf("  %12ld  skipped: needs about %.1f GB, more than half of the available memory\n", depth,
+                   bytes_per_element * (double)depth / 1e9);
+            break;
+        }
+        malloc_trim(0);
+        size_t heap_before = heap_in_use();
+        size_t rss_before = resident_bytes();
+
+        void *queue = backend->create();
+        for (long i = 0; i < depth; i++)
+        {
+            backend->push(queue, (int)i);
+        }
+        size_t heap = heap_in_use() - heap_before;
+        size_t rss = resident_bytes() - rss_before;
+        size_t api = backend->memory_usage ? backend->memory_usage(queue) : 0;
+        backend->destroy(queue);
+
+        bytes_per_element = (double)heap / (double)depth;
+        if (backend->memory_usage)
+        {
+            printf("  %12ld%16zu%16zu%16zu%10.2f%10.2f%10.2f\n", depth, api, heap, rss, (double)api / (double)depth,
+                   bytes_per_element, (double)rss / (double)depth);
+        }
+        else
+        {
+            printf("  %12ld%16s%16zu%16zu%10s%10.2f%10.2f\n", depth, "-", heap, rss, "-", bytes_per_element,
+                   (double)rss / (double)depth);
+        }
+        fflush(stdout);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long max_depth = argc > 1 ? atol(argv[1]) : DEFAULT_MAX_DEPTH;
+
+    queue_enable_auto_cleanup();
+    printf("bytes held by each backend at depths 1 to %ld (values 0, 1, 2, ...)\n", max_depth);
+    printf("api: the backend's own memory_usage call; heap: allocator in-use bytes incl. headers; rss: resident set\n\n");
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++)
+    {
+        run_backend(&backends[b], max_depth);
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "queue.h"
+#include "queue_metrics.h"
+
+#define DEFAULT_OPS 20000000
+#define QUEUES 4
+#define SAMPLE_INTERVAL_NS 1000000ULL
+
+static double now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/* Push/pop traffic spread over the queues, each kept at a depth that grows with its index */
+static double run_traffic(struct LinkedList **lists, long ops)
+{
+    double start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        struct LinkedList *list = lists[i % QUEUES];
+        queue_push(list, (int)i);
+        if (queue_size(list) > 1000 * (list->index % QUEUES + 1))
+        {
+            queue_pop(list);
+        }
+    }
+    return (now_ns() - start) / (double)ops;
+}
+
+int main(int argc, char **argv)
+{
+    long ops = argc > 1 ? atol(argv[1]) : DEFAULT_OPS;
+    queue_enable_auto_cleanup();
+
+    struct LinkedList *lists[QUEUES];
+    for (int q = 0; q < QUEUES; q++)
+    {
+        lists[q] = queue_create();
+    }
+
+    printf("%ld push/pop operations over %d queues\n", ops, QUEUES);
+    printf("%-34s%8.2f ns/op\n", "no sampler", run_traffic(lists, ops));
+
+    /* Samples taken here are discarded when the sampler starts */
+    double start = now_ns();
+    for (int i = 0; i < 1000; i++)
+    {
+        queue_metrics_sample();
+    }
+    printf("%-34s%8.2f us\n", "one sample of all queues", (now_ns() - start) / 1000.0 / 1e3);
+
+    queue_metrics_start(SAMPLE_INTERVAL_NS, 0);
+    double with_sampler = run_traffic(lists, ops);
+    queue_metrics_stop();
+    printf("%-34s%8.2f ns/op\n", "sampler every 1 ms", with_sampler);
+
+    struct QueueMetricsSample samples[QUEUE_METRICS_DEFAULT_CAPACITY];
+    printf("%-34s%8d\n", "samples kept for queue 0", queue_metrics_read(lists[0]->index, samples, QUEUE_METRICS_DEFAULT_CAPACITY));
+    printf("\nPrometheus export:\n");
+    queue_metrics_dump(stdout, QUEUE_METRICS_PROMETHEUS);
+    return 0;
+}
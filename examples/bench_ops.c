@@ -0,0 +1,287 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#ifdef BENCH_SINGLE_TU
+#define QUEUE_IMPLEMENTATION
+#endif
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "queue.h"
+#include "queue_define.h"
+#ifndef BENCH_SINGLE_TU
+#include "ms_queue.h"
+#include "seg_queue.h"
+#include "fc_queue.h"
+#include "elim_stack.h"
+#endif
+
+#define DEFAULT_OPS 1000000
+
+#if defined(BENCH_SINGLE_TU)
+#define BENCH_MODE "single translation unit (QUEUE_IMPLEMENTATION)"
+#elif defined(BENCH_LTO)
+#define BENCH_MODE "libqueue.a with link-time optimization"
+#else
+#define BENCH_MODE "libqueue.a"
+#endif
+
+QUEUE_DEFINE(int_queue, int, QUEUE_GROWABLE)
+
+static volatile long sink;
+
+static double now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static void report(const char *operation, double start, double end, long ops)
+{
+    printf("%-28s%10.2f ns/op\n", operation, (end - start) / (double)ops);
+}
+
+static void bench_linked_list(long ops)
+{
+    struct LinkedList *list = queue_create();
+    long sum = 0;
+
+    double start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        queue_push(list, (int)i);
+    }
+    double end = now_ns();
+    report("queue_push", start, end, ops);
+
+    start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        sum += queue_size(list) + queue_is_empty(list);
+    }
+    end = now_ns();
+    report("queue_size+queue_is_empty", start, end, ops);
+
+    start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        sum += queue_pop(list);
+    }
+    end = now_ns();
+    report("queue_pop", start, end, ops);
+
+    start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        queue_push_front(list, (int)i);
+    }
+    end = now_ns();
+    report("queue_push_front", start, end, ops);
+
+    start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        sum += queue_pop_back(list);
+    }
+    end = now_ns();
+    report("queue_pop_back", start, end, ops);
+
+    sink = sum;
+}
+
+static void bench_queue_define(long ops)
+{
+    struct int_queue queue;
+    int value = 0;
+    long sum = 0;
+    int_queue_init(&queue);
+
+    double start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        int_queue_push(&queue, (int)i);
+    }
+    double end = now_ns();
+    report("QUEUE_DEFINE push", start, end, ops);
+
+    start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        int_queue_pop(&queue, &value);
+        sum += value;
+    }
+    end = now_ns();
+    report("QUEUE_DEFINE pop", start, end, ops);
+
+    int_queue_destroy(&queue);
+    sink = sum;
+}
+
+#ifndef BENCH_SINGLE_TU
+struct Backend
+{
+    const char *name;
+    void *(*create)(void);
+    void (*push)(void *queue, int data);
+    bool (*pop)(void *queue, int *out_value);
+    void (*destroy)(void *queue);
+};
+
+static void *ms_create(void)
+{
+    return ms_queue_create(MS_QUEUE_RECLAIM_EPOCH);
+}
+
+static void ms_push(void *queue, int data)
+{
+    ms_queue_push(queue, data);
+}
+
+static bool ms_pop(void *queue, int *out_value)
+{
+    return ms_queue_pop(queue, out_value);
+}
+
+static void ms_destroy(void *queue)
+{
+    ms_queue_free(queue);
+}
+
+static void *seg_create(void)
+{
+    return seg_queue_create();
+}
+
+static void seg_push(void *queue, int data)
+{
+    seg_queue_push(queue, data);
+}
+
+static bool seg_pop(void *queue, int *out_value)
+{
+    return seg_queue_pop(queue, out_value);
+}
+
+static void seg_destroy(void *queue)
+{
+    seg_queue_free(queue);
+}
+
+static void *fc_create(void)
+{
+    return fc_queue_create(queue_create(), &linked_list_ops);
+}
+
+static void fc_push(void *queue, int data)
+{
+    fc_queue_push(queue, data);
+}
+
+static bool fc_pop(void *queue, int *out_value)
+{
+    return fc_queue_pop(queue, out_value);
+}
+
+static void fc_destroy(void *queue)
+{
+    fc_queue_free(queue);
+}
+
+static void *stack_create(void)
+{
+    return elim_stack_create(ELIM_STACK_DEFAULT_WIDTH);
+}
+
+static void stack_push(void *queue, int data)
+{
+    elim_stack_push(queue, data);
+}
+
+static bool stack_pop(void *queue, int *out_value)
+{
+    return elim_stack_pop(queue, out_value);
+}
+
+static void stack_destroy(void *queue)
+{
+    elim_stack_free(queue);
+}
+
+static const struct Backend backends[] = {
+    {"ms_queue", ms_create, ms_push, ms_pop, ms_destroy},
+    {"seg_queue", seg_create, seg_push, seg_pop, seg_destroy},
+    {"fc_queue", fc_create, fc_push, fc_pop, fc_destroy},
+    {"elim_stack", stack_create, stack_push, stack_pop, stack_destroy},
+};
+
+static void bench_backend(const struct Backend *backend, long ops)
+{
+    char label[64];
+    void *queue = backend->create();
+    int value = 0;
+    long sum = 0;
+
+    double start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        backend->push(queue, (int)i);
+    }
+    double end = now_ns();
+    snprintf(label, sizeof(label), "%s push", backend->name);
+    report(label, start, end, ops);
+
+    start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        backend->pop(queue, &value);
+        sum += value;
+    }
+    end = now_ns();
+    snprintf(label, sizeof(label), "%s pop", backend->name);
+    report(label, start, end, ops);
+
+    backend->destroy(queue);
+    sink = sum;
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    long ops = argc > 1 ? atol(argv[1]) : DEFAULT_OPS;
+
+    printf("mode: %s, %ld operations\n", BENCH_MODE, ops);
+    bench_linked_list(ops);
+    bench_queue_define(ops);
+#ifndef BENCH_SINGLE_TU
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++)
+    {
+        bench_backend(&backends[b], ops);
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,270 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include "queue.h"
+#include "thread_pool.h"
+
+#define DEFAULT_WORKERS 4
+#define DEFAULT_TASKS 200000
+#define NAIVE_CAPACITY THREAD_POOL_DEFAULT_CAPACITY
+
+static double now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/* Task bodies: an empty task measures pure dispatch, a short loop a realistic small task */
+static atomic_long tasks_done;
+static int task_work;
+
+static void task(void *arg)
+{
+    (void)arg;
+    volatile long sink = 0;
+    for (int i = 0; i < task_work; i++)
+    {
+        sink += i;
+    }
+    atomic_fetch_add_explicit(&tasks_done, 1, memory_order_relaxed);
+}
+
+/* Naive pool: one mutex and two condition variables around a LinkedList of task indices */
+struct NaiveTask
+{
+    void (*fn)(void *arg);
+    void *arg;
+};
+
+struct NaivePool
+{
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    pthread_cond_t all_done;
+    struct LinkedList *list;
+    struct NaiveTask tasks[NAIVE_CAPACITY];
+    long next;
+    int queued;
+    long in_flight;
+    bool stopping;
+    int worker_count;
+    pthread_t *workers;
+};
+
+static void *naive_worker(void *arg)
+{
+    struct NaivePool *pool = arg;
+    for (;;)
+    {
+        pthread_mutex_lock(&pool->lock);
+        while (queue_is_empty(pool->list) && !pool->stopping)
+        {
+            pthread_cond_wait(&pool->not_empty, &pool->lock);
+        }
+        if (queue_is_empty(pool->list))
+        {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        struct NaiveTask task = pool->tasks[queue_pop(pool->list)];
+        pool->queued--;
+        pthread_cond_signal(&pool->not_full);
+        pthread_mutex_unlock(&pool->lock);
+
+        task.fn(task.arg);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->in_flight == 0)
+        {
+            pthread_cond_broadcast(&pool->all_done);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static struct NaivePool *naive_create(int workers)
+{
+    struct NaivePool *pool = calloc(1, sizeof(struct NaivePool));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->not_empty, NULL);
+    pthread_cond_init(&pool->not_full, NULL);
+    pthread_cond_init(&pool->all_done, NULL);
+    pool->list = queue_create();
+    pool->worker_count = workers;
+    pool->workers = malloc((size_t)workers * sizeof(pthread_t));
+    for (int i = 0; i < workers; i++)
+    {
+        pthread_create(&pool->workers[i], NULL, naive_worker, pool);
+    }
+    return pool;
+}
+
+static void naive_submit(struct NaivePool *pool, void (*fn)(void *arg), void *arg)
+{
+    pthread_mutex_lock(&pool->lock);
+    while (pool->queued == NAIVE_CAPACITY)
+    {
+        pthread_cond_wait(&pool->not_full, &pool->lock);
+    }
+    int slot = (int)(pool->next++ % NAIVE_CAPACITY);
+    pool->tasks[slot] = (struct NaiveTask){fn, arg};
+    queue_push(pool->list, slot);
+    pool->queued++;
+    pool->in_flight++;
+    pthread_cond_signal(&pool->not_empty);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void naive_wait(struct NaivePool *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    while (pool->in_flight > 0)
+    {
+        pthread_cond_wait(&pool->all_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void naive_free(struct NaivePool *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->not_empty);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->worker_count; i++)
+    {
+        pthread_join(pool->workers[i], NULL);
+    }
+    free(pool->workers);
+    free(pool);
+}
+
+static void report(const char *pool, double start, double end, long tasks, const struct ThreadPoolStats *stats)
+{
+    printf("  %-22s%10.1f ns/task%12.2f Mtasks/s", pool, (end - start) / tasks, tasks / (end - start) * 1e3);
+    if (stats)
+    {
+        printf("   helped %llu, parks %llu, wakeups %llu, full %llu", (unsigned long long)stats->helped,
+               (unsigned long long)stats->parks, (unsigned long long)stats->wakeups,
+               (unsigned long long)stats->full_stalls);
+    }
+    printf("\n");
+}
+
+static void bench_naive(int workers, long tasks)
+{
+    struct NaivePool *pool = naive_create(workers);
+    atomic_store(&tasks_done, 0);
+    double start = now_ns();
+    for (long i = 0; i < tasks; i++)
+    {
+        naive_submit(pool, task, NULL);
+    }
+    naive_wait(pool);
+    double end = now_ns();
+    naive_free(pool);
+    report("mutex+condvar", start, end, tasks, NULL);
+}
+
+static void bench_pool(const char *name, enum ThreadPoolQueue queue, int workers, long tasks)
+{
+    struct ThreadPool *pool = thread_pool_create(workers, queue, 0);
+    atomic_store(&tasks_done, 0);
+    double start = now_ns();
+    for (long i = 0; i < tasks; i++)
+    {
+        thread_pool_submit(pool, task, NULL);
+    }
+    thread_pool_wait(pool);
+    double end = now_ns();
+    struct ThreadPoolStats stats;
+    thread_pool_get_stats(pool, &stats);
+    thread_pool_free(pool);
+    if (atomic_load(&tasks_done) != tasks)
+    {
+        fprintf(stderr, "ERROR: %s ran %ld of %ld tasks.\n", name, atomic_load(&tasks_done), tasks);
+        exit(EXIT_FAILURE);
+    }
+    report(name, start, end, tasks, &stats);
+}
+
+static void sum_range(void *arg, long begin, long end)
+{
+    long sum = 0;
+    for (long i = begin; i < end; i++)
+    {
+        sum += i & 7;
+    }
+    atomic_fetch_add_explicit((atomic_long *)arg, sum, memory_order_relaxed);
+}
+
+static void bench_parallel_for(int workers, long count)
+{
+    struct ThreadPool *pool = thread_pool_create(workers, THREAD_POOL_SEG_QUEUE, 0);
+    long grains[] = {0, 1000, 100000};
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++)
+    {
+        atomic_long sum = 0;
+        double start = now_ns();
+        thread_pool_parallel_for(pool, 0, count, grains[g], sum_range, &sum);
+        double end = now_ns();
+        if (atomic_load(&sum) != (count / 8) * 28 + ((count % 8) * (count % 8 - 1)) / 2)
+        {
+            fprintf(stderr, "ERROR: parallel_for computed a wrong sum.\n");
+            exit(EXIT_FAILURE);
+        }
+        printf("  grain %-8ld%10.2f ms%12.2f ns/index\n", grains[g], (end - start) / 1e6, (end - start) / count);
+    }
+    thread_pool_free(pool);
+}
+
+int main(int argc, char **argv)
+{
+    int workers = argc > 1 ? atoi(argv[1]) : DEFAULT_WORKERS;
+    long tasks = argc > 2 ? atol(argv[2]) : DEFAULT_TASKS;
+
+    queue_enable_auto_cleanup();
+    int works[] = {0, 1000};
+    for (size_t w = 0; w < sizeof(works) / sizeof(works[0]); w++)
+    {
+        task_work = works[w];
+        printf("%d workers, %ld tasks of %d loop iterations, one submitter\n", workers, tasks, task_work);
+        bench_naive(workers, tasks);
+        bench_pool("thread_pool/seg_queue", THREAD_POOL_SEG_QUEUE, workers, tasks);
+        bench_pool("thread_pool/ms_queue", THREAD_POOL_MS_QUEUE, workers, tasks);
+        bench_pool("thread_pool/fc_queue", THREAD_POOL_FC_QUEUE, workers, tasks);
+    }
+    printf("parallel_for over %ld indices\n", tasks * 100);
+    bench_parallel_for(workers, tasks * 100);
+    return 0;
+}
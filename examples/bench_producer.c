@@ -0,0 +1,176 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include "ms_queue.h"
+#include "producer_cache.h"
+
+#define DEFAULT_PRODUCERS 4
+#define DEFAULT_OPS_PER_PRODUCER 500000
+#define TRICKLE_INTERVAL_NS 20000
+#define TRICKLE_OPS 2000
+#define ADAPTIVE_TARGET_NS 50000
+
+struct Run
+{
+    struct MSQueue *queue;
+    int capacity;
+    uint64_t max_delay_ns;
+    uint64_t target_ns;
+    long ops;
+    uint64_t interval_ns;
+    atomic_int producers_left;
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static void pause_ns(uint64_t ns)
+{
+    struct timespec delay = {0, (long)ns};
+    nanosleep(&delay, NULL);
+}
+
+/* Values carry the push time in microseconds, so the consumer can measure the delay */
+static int timestamp_us(uint64_t base)
+{
+    return (int)((now_ns() - base) / 1000);
+}
+
+static uint64_t base_ns;
+
+static void *producer_run(void *arg)
+{
+    struct Run *run = arg;
+    struct ProducerCache *cache = run->capacity > 1 ? producer_cache_create(run->queue, run->capacity, run->max_delay_ns) : NULL;
+    if (cache && run->target_ns)
+    {
+        producer_cache_set_target_latency(cache, run->target_ns);
+    }
+    for (long i = 0; i < run->ops; i++)
+    {
+        int value = timestamp_us(base_ns);
+        if (cache)
+        {
+            producer_cache_push(cache, value);
+        }
+        else
+        {
+            ms_queue_push(run->queue, value);
+        }
+        if (run->interval_ns)
+        {
+            pause_ns(run->interval_ns);
+            if (cache)
+            {
+                producer_cache_poll(cache);
+            }
+        }
+    }
+    if (cache)
+    {
+        producer_cache_free(cache);
+    }
+    atomic_fetch_sub(&run->producers_left, 1);
+    return NULL;
+}
+
+static int compare_ints(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_case(const char *name, int producers, long ops, int capacity, uint64_t max_delay_ns, uint64_t target_ns,
+                     uint64_t interval_ns)
+{
+    struct Run run = {.queue = ms_queue_create(MS_QUEUE_RECLAIM_EPOCH), .capacity = capacity,
+                      .max_delay_ns = max_delay_ns, .target_ns = target_ns, .ops = ops, .interval_ns = interval_ns};
+    atomic_init(&run.producers_left, producers);
+    long total = (long)producers * ops;
+    int *latencies = malloc((size_t)total * sizeof(int));
+
+    base_ns = now_ns();
+    uint64_t start = now_ns();
+    pthread_t *ids = malloc((size_t)producers * sizeof(pthread_t));
+    for (int p = 0; p < producers; p++)
+    {
+        pthread_create(&ids[p], NULL, producer_run, &run);
+    }
+
+    long received = 0;
+    int value;
+    while (received < total)
+    {
+        if (ms_queue_pop(run.queue, &value))
+        {
+            latencies[received++] = timestamp_us(base_ns) - value;
+        }
+        else if (atomic_load(&run.producers_left) == 0 && ms_queue_is_empty(run.queue))
+        {
+            break;
+        }
+    }
+    uint64_t elapsed = now_ns() - start;
+    for (int p = 0; p < producers; p++)
+    {
+        pthread_join(ids[p], NULL);
+    }
+
+    qsort(latencies, (size_t)received, sizeof(int), compare_ints);
+    printf("%-30s%10.2f Mops%10d us p50%10d us p99%10d us max\n", name, (double)received / (double)elapsed * 1e3,
+           latencies[received / 2], latencies[received * 99 / 100], latencies[received - 1]);
+    free(latencies);
+    free(ids);
+    ms_queue_free(run.queue);
+}
+
+int main(int argc, char **argv)
+{
+    int producers = argc > 1 ? atoi(argv[1]) : DEFAULT_PRODUCERS;
+    long ops = argc > 2 ? atol(argv[2]) : DEFAULT_OPS_PER_PRODUCER;
+
+    printf("%d producers, 1 consumer, %ld pushes per producer\n", producers, ops);
+    run_case("ms_queue_push", producers, ops, 1, 0, 0, 0);
+    run_case("producer cache (64)", producers, ops, 64, PRODUCER_CACHE_DEFAULT_MAX_DELAY_NS, 0, 0);
+    run_case("producer cache (256)", producers, ops, 256, PRODUCER_CACHE_DEFAULT_MAX_DELAY_NS, 0, 0);
+    run_case("adaptive (256, 50 us SLO)", producers, ops, 256, 0, ADAPTIVE_TARGET_NS, 0);
+
+    printf("\ntrickle: one push every %d us per producer\n", TRICKLE_INTERVAL_NS / 1000);
+    run_case("ms_queue_push", producers, TRICKLE_OPS, 1, 0, 0, TRICKLE_INTERVAL_NS);
+    run_case("producer cache, no time bound", producers, TRICKLE_OPS, 64, 0, 0, TRICKLE_INTERVAL_NS);
+    run_case("producer cache, 100 us bound", producers, TRICKLE_OPS, 64, PRODUCER_CACHE_DEFAULT_MAX_DELAY_NS, 0, TRICKLE_INTERVAL_NS);
+    run_case("adaptive (256, 50 us SLO)", producers, TRICKLE_OPS, 256, 0, ADAPTIVE_TARGET_NS, TRICKLE_INTERVAL_NS);
+    return 0;
+}
@@ -0,0 +1,302 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+#include "queue.h"
+#include "ms_queue.h"
+#include "seg_queue.h"
+#include "fc_queue.h"
+#include "epoch.h"
+
+#define DEFAULT_MAX_THREADS 64
+#define DEFAULT_OPS_PER_THREAD 200000
+
+struct Backend
+{
+    const char *name;
+    void *(*create)(void);
+    void (*push)(void *queue, int data);
+    bool (*pop)(void *queue, int *out_value);
+    void (*destroy)(void *queue);
+    bool qsbr;
+};
+
+struct MutexQueue
+{
+    pthread_mutex_t lock;
+    struct LinkedList *list;
+};
+
+static void *mutex_create(void)
+{
+    struct MutexQueue *queue = malloc(sizeof(struct MutexQueue));
+    pthread_mutex_init(&queue->lock, NULL);
+    queue->list = queue_create();
+    return queue;
+}
+
+static void mutex_push(void *queue, int data)
+{
+    struct MutexQueue *mutex_queue = queue;
+    pthread_mutex_lock(&mutex_queue->lock);
+    queue_push(mutex_queue->list, data);
+    pthread_mutex_unlock(&mutex_queue->lock);
+}
+
+static bool mutex_pop(void *queue, int *out_value)
+{
+    struct MutexQueue *mutex_queue = queue;
+    pthread_mutex_lock(&mutex_queue->lock);
+    bool found = !queue_is_empty(mutex_queue->list);
+    if (found)
+    {
+        *out_value = queue_pop(mutex_queue->list);
+    }
+    pthread_mutex_unlock(&mutex_queue->lock);
+    return found;
+}
+
+static void mutex_destroy(void *queue)
+{
+    struct MutexQueue *mutex_queue = queue;
+    if (!queue_is_empty(mutex_queue->list))
+    {
+        queue_free(mutex_queue->list);
+    }
+    pthread_mutex_destroy(&mutex_queue->lock);
+    free(mutex_queue);
+}
+
+static void *ms_hazard_create(void)
+{
+    return ms_queue_create(MS_QUEUE_RECLAIM_HAZARD);
+}
+
+static void *ms_epoch_create(void)
+{
+    return ms_queue_create(MS_QUEUE_RECLAIM_EPOCH);
+}
+
+static void ms_push(void *queue, int data)
+{
+    ms_queue_push(queue, data);
+}
+
+static bool ms_pop(void *queue, int *out_value)
+{
+    return ms_queue_pop(queue, out_value);
+}
+
+static void ms_destroy(void *queue)
+{
+    ms_queue_free(queue);
+}
+
+static void *seg_create(void)
+{
+    return seg_queue_create();
+}
+
+static void seg_push(void *queue, int data)
+{
+    seg_queue_push(queue, data);
+}
+
+static bool seg_pop(void *queue, int *out_value)
+{
+    return seg_queue_pop(queue, out_value);
+}
+
+static void seg_destroy(void *queue)
+{
+    seg_queue_free(queue);
+}
+
+struct CombinedQueue
+{
+    struct FCQueue *fc;
+    struct LinkedList *list;
+};
+
+static void *fc_create(void)
+{
+    struct CombinedQueue *queue = malloc(sizeof(struct CombinedQueue));
+    queue->list = queue_create();
+    queue->fc = fc_queue_create(queue->list, &linked_list_ops);
+    return queue;
+}
+
+static void fc_push(void *queue, int data)
+{
+    fc_queue_push(((struct CombinedQueue *)queue)->fc, data);
+}
+
+static bool fc_pop(void *queue, int *out_value)
+{
+    return fc_queue_pop(((struct CombinedQueue *)queue)->fc, out_value);
+}
+
+static void fc_destroy(void *queue)
+{
+    struct CombinedQueue *combined_queue = queue;
+    fc_queue_free(combined_queue->fc);
+    if (!queue_is_empty(combined_queue->list))
+    {
+        queue_free(combined_queue->list);
+    }
+    free(combined_queue);
+}
+
+static const struct Backend backends[] = {
+    {"mutex+LinkedList", mutex_create, mutex_push, mutex_pop, mutex_destroy, false},
+    {"fc+LinkedList", fc_create, fc_push, fc_pop, fc_destroy, false},
+    {"ms_queue/hazard", ms_hazard_create, ms_push, ms_pop, ms_destroy, false},
+    {"ms_queue/epoch", ms_epoch_create, ms_push, ms_pop, ms_destroy, false},
+    {"ms_queue/qsbr", ms_epoch_create, ms_push, ms_pop, ms_destroy, true},
+    {"seg_queue", seg_create, seg_push, seg_pop, seg_destroy, false},
+};
+
+struct Worker
+{
+    const struct Backend *backend;
+    void *queue;
+    pthread_barrier_t *barrier;
+    long ops;
+    struct timespec start;
+    struct timespec end;
+};
+
+static double elapsed_seconds(const struct timespec *start, const struct timespec *end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void *worker_run(void *arg)
+{
+    struct Worker *worker = arg;
+    int value;
+    if (worker->backend->qsbr)
+    {
+        epoch_thread_online();
+    }
+    pthread_barrier_wait(worker->barrier);
+    clock_gettime(CLOCK_MONOTONIC, &worker->start);
+    for (long i = 0; i < worker->ops; i++)
+    {
+        worker->backend->push(worker->queue, (int)i);
+        worker->backend->pop(worker->queue, &value);
+        if (worker->backend->qsbr)
+        {
+            epoch_quiescent();
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &worker->end);
+    if (worker->backend->qsbr)
+    {
+        epoch_thread_offline();
+    }
+    return NULL;
+}
+
+static double run_backend(const struct Backend *backend, int threads, long ops)
+{
+    void *queue = backend->create();
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, (unsigned)threads + 1);
+
+    pthread_t *ids = malloc((size_t)threads * sizeof(pthread_t));
+    struct Worker *workers = malloc((size_t)threads * sizeof(struct Worker));
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i] = (struct Worker){.backend = backend, .queue = queue, .barrier = &barrier, .ops = ops};
+        pthread_create(&ids[i], NULL, worker_run, &workers[i]);
+    }
+
+    pthread_barrier_wait(&barrier);
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(ids[i], NULL);
+    }
+
+    struct timespec start = workers[0].start, end = workers[0].end;
+    for (int i = 1; i < threads; i++)
+    {
+        if (elapsed_seconds(&workers[i].start, &start) > 0)
+        {
+            start = workers[i].start;
+        }
+        if (elapsed_seconds(&end, &workers[i].end) > 0)
+        {
+            end = workers[i].end;
+        }
+    }
+
+    pthread_barrier_destroy(&barrier);
+    free(workers);
+    free(ids);
+    backend->destroy(queue);
+
+    double seconds = elapsed_seconds(&start, &end);
+    return (double)threads * (double)ops * 2.0 / seconds / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    int max_threads = argc > 1 ? atoi(argv[1]) : DEFAULT_MAX_THREADS;
+    long ops = argc > 2 ? atol(argv[2]) : DEFAULT_OPS_PER_THREAD;
+
+    printf("%-20s", "threads");
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++)
+    {
+        printf("%20s", backends[b].name);
+    }
+    printf("\n");
+
+    for (int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        printf("%-20d", threads);
+        for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++)
+        {
+            printf("%15.2f Mops", run_backend(&backends[b], threads, ops));
+            fflush(stdout);
+        }
+        printf("\n");
+    }
+
+    struct EpochStats stats;
+    epoch_get_stats(&stats);
+    printf("\nepoch reclamation: epoch %llu, %llu advances, %llu retired, %llu reclaimed in %llu batches\n",
+           (unsigned long long)stats.epoch, (unsigned long long)stats.advances, (unsigned long long)stats.retired,
+           (unsigned long long)stats.reclaimed, (unsigned long long)stats.reclaim_batches);
+    printf("pending %llu nodes (%llu bytes, %llu bytes of retire lists), reclaim latency avg %.1f us, max %.1f us\n",
+           (unsigned long long)stats.pending, (unsigned long long)stats.pending_bytes, (unsigned long long)stats.list_bytes,
+           stats.reclaim_batches ? (double)stats.total_reclaim_latency_ns / (double)stats.reclaim_batches / 1e3 : 0.0,
+           (double)stats.max_reclaim_latency_ns / 1e3);
+    return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include "queue.h"
+#include "set_queue.h"
+
+#define DEFAULT_MAX_DEPTH 100000
+#define DEFAULT_OPS 200000
+
+/* xorshift64: cheap, reproducible work IDs */
+static uint64_t rng_state = 88172645463325252ull;
+
+static int next_id(int id_range)
+{
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (int)(rng_state % (uint64_t)id_range);
+}
+
+static double now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/* Steady state at `depth`: each op offers one random ID from [0, 2 * depth) and pops one element when an ID was added */
+static void run_linked_list(int depth, long ops)
+{
+    struct LinkedList *list = queue_create();
+    int id_range = 2 * depth;
+    long added = 0;
+    for (int i = 0; i < depth; i++)
+    {
+        queue_push(list, i * 2);
+    }
+    double start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        int id = next_id(id_range);
+        if (queue_search(list, id) < 0)
+        {
+            queue_push(list, id);
+            queue_pop(list);
+            added++;
+        }
+    }
+    double elapsed = now_ns() - start;
+    printf("%-26s%10d%12.1f%10.1f%%%14zu\n", "queue_search + queue_push", depth, elapsed / (double)ops,
+           100.0 * (double)added / (double)ops, queue_memory_usage(list));
+    queue_free(list);
+}
+
+static void run_set_queue(const char *name, struct SetQueue *queue, int depth, long ops)
+{
+    int id_range = 2 * depth;
+    long added = 0;
+    int value;
+    for (int i = 0; i < depth; i++)
+    {
+        set_queue_push(queue, i * 2);
+    }
+    double start = now_ns();
+    for (long i = 0; i < ops; i++)
+    {
+        if (set_queue_push(queue, next_id(id_range)))
+        {
+            set_queue_pop(queue, &value);
+            added++;
+        }
+    }
+    double elapsed = now_ns() - start;
+    printf("%-26s%10d%12.1f%10.1f%%%14zu\n", name, depth, elapsed / (double)ops, 100.0 * (double)added / (double)ops,
+           set_queue_memory_usage(queue));
+    set_queue_free(queue);
+}
+
+int main(int argc, char **argv)
+{
+    int max_depth = argc > 1 ? atoi(argv[1]) : DEFAULT_MAX_DEPTH;
+    long ops = argc > 2 ? atol(argv[2]) : DEFAULT_OPS;
+    if (max_depth <= 0 || ops <= 0)
+    {
+        fprintf(stderr, "usage: %s [max_depth] [ops]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    queue_enable_auto_cleanup();
+    printf("%-26s%10s%12s%11s%14s\n", "method", "depth", "ns/op", "added", "bytes");
+    for (int depth = 10; depth <= max_depth; depth *= 10)
+    {
+        /* The linear search is O(depth) per op; cap its work so deep backlogs still finish */
+        long list_ops = ops;
+        while (list_ops > 1000 && (double)list_ops * depth > 2e9)
+        {
+            list_ops /= 10;
+        }
+        run_linked_list(depth, list_ops);
+        run_set_queue("set_queue (hash set)", set_queue_create(), depth, ops);
+        run_set_queue("set_queue (bitmap)", set_queue_create_range(0, 2 * depth - 1), depth, ops);
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+#include "elim_stack.h"
+
+#define DEFAULT_MAX_THREADS 64
+#define DEFAULT_OPS_PER_THREAD 200000
+
+struct Worker
+{
+    struct ElimStack *stack;
+    pthread_barrier_t *barrier;
+    long ops;
+    struct timespec start;
+    struct timespec end;
+};
+
+static double elapsed_seconds(const struct timespec *start, const struct timespec *end)
+{
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void *worker_run(void *arg)
+{
+    struct Worker *worker = arg;
+    int value;
+    pthread_barrier_wait(worker->barrier);
+    clock_gettime(CLOCK_MONOTONIC, &worker->start);
+    for (long i = 0; i < worker->ops; i++)
+    {
+        elim_stack_push(worker->stack, (int)i);
+        elim_stack_pop(worker->stack, &value);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &worker->end);
+    return NULL;
+}
+
+static double run_stack(int width, int threads, long ops)
+{
+    struct ElimStack *stack = elim_stack_create(width);
+    pthread_barrier_t barrier;
+    pthread_barrier_init(&barrier, NULL, (unsigned)threads);
+
+    pthread_t *ids = malloc((size_t)threads * sizeof(pthread_t));
+    struct Worker *workers = malloc((size_t)threads * sizeof(struct Worker));
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i] = (struct Worker){.stack = stack, .barrier = &barrier, .ops = ops};
+        pthread_create(&ids[i], NULL, worker_run, &workers[i]);
+    }
+    for (int i = 0; i < threads; i++)
+    {
+        pthread_join(ids[i], NULL);
+    }
+
+    struct timespec start = workers[0].start, end = workers[0].end;
+    for (int i = 1; i < threads; i++)
+    {
+        if (elapsed_seconds(&workers[i].start, &start) > 0)
+        {
+            start = workers[i].start;
+        }
+        if (elapsed_seconds(&end, &workers[i].end) > 0)
+        {
+            end = workers[i].end;
+        }
+    }
+
+    pthread_barrier_destroy(&barrier);
+    free(workers);
+    free(ids);
+    elim_stack_free(stack);
+    return (double)threads * (double)ops * 2.0 / elapsed_seconds(&start, &end) / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+    int max_threads = argc > 1 ? atoi(argv[1]) : DEFAULT_MAX_THREADS;
+    long ops = argc > 2 ? atol(argv[2]) : DEFAULT_OPS_PER_THREAD;
+
+    printf("%-20s%20s%20s\n", "threads", "treiber", "elimination");
+    for (int threads = 2; threads <= max_threads; threads *= 2)
+    {
+        printf("%-20d", threads);
+        printf("%15.2f Mops", run_stack(0, threads, ops));
+        fflush(stdout);
+        printf("%15.2f Mops\n", run_stack(ELIM_STACK_DEFAULT_WIDTH, threads, ops));
+    }
+    return 0;
+}
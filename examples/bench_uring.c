@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "queue.h"
+#include "uring_sink.h"
+
+#define DEFAULT_ELEMENTS 1000000
+
+static double now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static void fill(struct LinkedList *list, long elements)
+{
+    for (long i = 0; i < elements; i++)
+    {
+        queue_push(list, (int)i);
+    }
+}
+
+static void report(const char *target, const char *method, double start, double end, long elements, unsigned long syscalls)
+{
+    double seconds = (end - start) / 1e9;
+    printf("%-6s %-18s%12.2f M elements/s%12lu syscalls\n", target, method, (double)elements / seconds / 1e6, syscalls);
+}
+
+static long drain_with_write(struct LinkedList *list, int fd, unsigned long *syscalls)
+{
+    long total = 0;
+    while (!queue_is_empty(list))
+    {
+        int value = queue_pop(list);
+        if (write(fd, &value, sizeof(value)) != (ssize_t)sizeof(value))
+        {
+            return -1;
+        }
+        (*syscalls)++;
+        total++;
+    }
+    return total;
+}
+
+static void *pipe_reader(void *arg)
+{
+    int fd = *(int *)arg;
+    char buffer[1 << 16];
+    long sum = 0;
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+    {
+        sum += n;
+    }
+    return (void *)sum;
+}
+
+static bool verify_file(int fd, long elements)
+{
+    int value;
+    for (long i = 0; i < elements; i++)
+    {
+        if (pread(fd, &value, sizeof(value), (off_t)(i * (long)sizeof(value))) != (ssize_t)sizeof(value) || value != (int)i)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void bench_file(long elements, bool use_uring)
+{
+    char path[] = "/tmp/bench_uring_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0)
+    {
+        perror("mkstemp");
+        return;
+    }
+    unlink(path);
+
+    struct LinkedList *list = queue_create();
+    fill(list, elements);
+    unsigned long syscalls = 0;
+    long written;
+    double start, end;
+    if (use_uring)
+    {
+        struct UringSink *sink = uring_sink_create(fd, 0, 0);
+        if (!sink)
+        {
+            close(fd);
+            return;
+        }
+        start = now_ns();
+        written = uring_sink_drain(sink, list);
+        end = now_ns();
+        struct UringSinkStats stats;
+        uring_sink_get_stats(sink, &stats);
+        syscalls = (unsigned long)stats.syscalls;
+        uring_sink_free(sink);
+    }
+    else
+    {
+        start = now_ns();
+        written = drain_with_write(list, fd, &syscalls);
+        end = now_ns();
+    }
+    report("file", use_uring ? "io_uring sink" : "write() per elem", start, end, written, syscalls);
+    if (!verify_file(fd, elements))
+    {
+        fprintf(stderr, "ERROR: segment file contents do not match the queue.\n");
+    }
+    close(fd);
+}
+
+static void bench_pipe(long elements, bool use_uring)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        perror("pipe");
+        return;
+    }
+    pthread_t reader;
+    pthread_create(&reader, NULL, pipe_reader, &fds[0]);
+
+    struct LinkedList *list = queue_create();
+    fill(list, elements);
+    unsigned long syscalls = 0;
+    long written = 0;
+    double start = now_ns();
+    if (use_uring)
+    {
+        struct UringSink *sink = uring_sink_create(fds[1], 0, 0);
+        if (sink)
+        {
+            written = uring_sink_drain(sink, list);
+            struct UringSinkStats stats;
+            uring_sink_get_stats(sink, &stats);
+            syscalls = (unsigned long)stats.syscalls;
+            uring_sink_free(sink);
+        }
+    }
+    else
+    {
+        written = drain_with_write(list, fds[1], &syscalls);
+    }
+    close(fds[1]);
+    void *received;
+    pthread_join(reader, &received);
+    double end = now_ns();
+    report("pipe", use_uring ? "io_uring sink" : "write() per elem", start, end, written, syscalls);
+    if ((long)received != written * (long)sizeof(int))
+    {
+        fprintf(stderr, "ERROR: pipe reader received %ld bytes, expected %ld.\n", (long)received, written * (long)sizeof(int));
+    }
+    close(fds[0]);
+}
+
+int main(int argc, char **argv)
+{
+    long elements = argc > 1 ? atol(argv[1]) : DEFAULT_ELEMENTS;
+    queue_enable_auto_cleanup();
+    printf("draining %ld elements\n", elements);
+    bench_file(elements, false);
+    bench_file(elements, true);
+    bench_pipe(elements, false);
+    bench_pipe(elements, true);
+    return 0;
+}
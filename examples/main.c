@@ -71,6 +71,7 @@ void test_queue_operations()
 
 int main(void)
 {
+    queue_enable_auto_cleanup();
     test_queue_operations();
     return 0;
 }
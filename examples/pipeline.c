@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Four-stage pipeline: parse -> enrich -> aggregate -> sink.
+ *
+ * The main thread feeds raw records into the parse stage. Each stage runs on its own
+ * pinned thread(s), with a bounded queue in front of it, and the stage stats are
+ * printed at the end. Enrich is the slowest stage, so parse and the main thread are
+ * held back by backpressure instead of filling memory.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdatomic.h>
+#include "pipeline.h"
+
+#define DEFAULT_RECORDS 2000000
+#define CATEGORIES 16
+#define WINDOW 10000
+#define ENRICH_WORK 200
+
+static int category_table[1024];
+
+/* Drops malformed records (negative values) and passes the rest on */
+static void parse(void *context, const int *values, int count, struct PipelineEmitter *emitter)
+{
+    atomic_long *malformed = context;
+    for (int i = 0; i < count; i++)
+    {
+        if (values[i] < 0)
+        {
+            atomic_fetch_add_explicit(malformed, 1, memory_order_relaxed);
+            continue;
+        }
+        pipeline_emit(emitter, 0, values[i]);
+    }
+}
+
+/* Looks up the record's category and packs it into the top byte; the loop stands in for real work */
+static void enrich(void *context, const int *values, int count, struct PipelineEmitter *emitter)
+{
+    (void)context;
+    for (int i = 0; i < count; i++)
+    {
+        volatile int work = 0;
+        for (int w = 0; w < ENRICH_WORK; w++)
+        {
+            work += w;
+        }
+        int category = category_table[values[i] % 1024];
+        pipeline_emit(emitter, 0, (category << 24) | (values[i] & 0xffffff));
+    }
+}
+
+/* Counts records per category and emits an event each time a category fills another window */
+static void aggregate(void *context, const int *values, int count, struct PipelineEmitter *emitter)
+{
+    long *totals = context;
+    for (int i = 0; i < count; i++)
+    {
+        int category = values[i] >> 24;
+        if (++totals[category] % WINDOW == 0)
+        {
+            pipeline_emit(emitter, 0, (category << 24) | (int)(totals[category] / WINDOW));
+        }
+    }
+}
+
+static void sink(void *context, const int *values, int count, struct PipelineEmitter *emitter)
+{
+    (void)values;
+    (void)emitter;
+    atomic_fetch_add_explicit((atomic_long *)context, count, memory_order_relaxed);
+}
+
+static void print_stats(struct Pipeline *pipeline)
+{
+    printf("%-10s%8s%12s%12s%10s%12s%12s%10s%14s%12s\n", "stage", "threads", "consumed", "emitted", "batches",
+           "full waits", "empty polls", "busy ms", "values/s", "depth");
+    for (int s = 0; s < pipeline_stage_count(pipeline); s++)
+    {
+        struct PipelineStageStats stats;
+        pipeline_get_stage_stats(pipeline, s, &stats);
+        printf("%-10s%8d%12llu%12llu%10llu%12llu%12llu%10.1f%14.0f%7d/%d\n", stats.name, stats.threads,
+               (unsigned long long)stats.consumed, (unsigned long long)stats.emitted,
+               (unsigned long long)stats.batches, (unsigned long long)stats.full_stalls,
+               (unsigned long long)stats.empty_polls, stats.busy_ns / 1e6, stats.throughput, stats.queue_depth,
+               stats.queue_capacity);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    long records = argc > 1 ? atol(argv[1]) : DEFAULT_RECORDS;
+    for (int i = 0; i < 1024; i++)
+    {
+        category_table[i] = (i * 7) % CATEGORIES;
+    }
+
+    atomic_long malformed = 0;
+    atomic_long events = 0;
+    long totals[CATEGORIES] = {0};
+
+    struct Pipeline *pipeline = pipeline_create(4096, 64);
+    int parse_stage = pipeline_add_stage(pipeline, "parse", parse, &malformed, 1, 0);
+    int enrich_stage = pipeline_add_stage(pipeline, "enrich", enrich, NULL, 2, 1);
+    int aggregate_stage = pipeline_add_stage(pipeline, "aggregate", aggregate, totals, 1, 3);
+    int sink_stage = pipeline_add_stage(pipeline, "sink", sink, &events, 1, 4);
+    pipeline_connect(pipeline, parse_stage, enrich_stage);
+    pipeline_connect(pipeline, enrich_stage, aggregate_stage);
+    pipeline_connect(pipeline, aggregate_stage, sink_stage);
+    pipeline_start(pipeline);
+
+    int batch[256];
+    unsigned int state = 1;
+    for (long sent = 0; sent < records; sent += 256)
+    {
+        int count = records - sent < 256 ? (int)(records - sent) : 256;
+        for (int i = 0; i < count; i++)
+        {
+            state = state * 1103515245u + 12345u;
+            int record = (int)((state >> 8) & 0xffffff);
+            batch[i] = record % 100 == 0 ? -record : record;
+        }
+        pipeline_push_bulk(pipeline, parse_stage, batch, count);
+        if (sent == (records / 2 / 256) * 256)
+        {
+            printf("halfway, while running:\n");
+            print_stats(pipeline);
+            printf("\n");
+        }
+    }
+    pipeline_close(pipeline);
+    pipeline_wait(pipeline);
+
+    printf("done:\n");
+    print_stats(pipeline);
+    printf("\n%ld records, %ld malformed, %ld window events\n", records, atomic_load(&malformed), atomic_load(&events));
+    for (int c = 0; c < CATEGORIES; c++)
+    {
+        printf("category %2d: %ld\n", c, totals[c]);
+    }
+    pipeline_free(pipeline);
+    return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef AFFINITY_H
+#define AFFINITY_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Maximum number of CPUs the topology describes and of queues with a placement policy
+#define AFFINITY_MAX_CPUS 1024
+#define AFFINITY_MAX_QUEUES 100
+
+// One usable CPU; core and llc name a group by its lowest CPU, socket is the physical package id
+struct CpuInfo
+{
+    int cpu;
+    int core;
+    int llc;
+    int socket;
+};
+
+// CPUs this process may run on, with the cores, last-level caches and sockets they share
+struct CpuTopology
+{
+    int cpu_count;
+    int core_count;
+    int llc_count;
+    int socket_count;
+    int llc_level;
+    struct CpuInfo cpus[AFFINITY_MAX_CPUS];
+};
+
+// Where a queue's consumer runs relative to its producer
+enum AffinityPlacement
+{
+    AFFINITY_SAME_CPU,
+    AFFINITY_SMT_SIBLING,
+    AFFINITY_SAME_LLC,
+    AFFINITY_CROSS_LLC,
+    AFFINITY_CROSS_SOCKET,
+    AFFINITY_PLACEMENTS
+};
+
+QUEUE_API const struct CpuTopology *affinity_topology(void);
+QUEUE_API void affinity_print_topology(FILE *out);
+QUEUE_API const char *affinity_placement_name(enum AffinityPlacement placement);
+QUEUE_API bool affinity_find_pair(enum AffinityPlacement placement, int *out_producer_cpu, int *out_consumer_cpu);
+QUEUE_API bool affinity_pin_thread(int cpu);
+QUEUE_API bool affinity_set_policy(const void *queue, enum AffinityPlacement placement);
+QUEUE_API int affinity_register_producer(const void *queue);
+QUEUE_API int affinity_register_consumer(const void *queue);
+QUEUE_API void affinity_unregister(const void *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,375 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ASYNC_QUEUE_HPP
+#define ASYNC_QUEUE_HPP
+
+#include <atomic>
+#include <climits>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <new>
+#include "seg_queue.h"
+#include "queue_trace.h"
+
+// Maximum number of waiters handed to the executor in one call when a push wakes several
+#define ASYNC_QUEUE_WAKE_BATCH 64
+
+namespace queue
+{
+
+// Runs resumed coroutines, e.g. on a thread pool or an event loop
+template <typename E>
+concept Executor = requires(E &executor, std::coroutine_handle<> handle) {
+    executor.execute(handle);
+};
+
+// Executor that can also take a whole batch of resumed coroutines in one call
+template <typename E>
+concept BatchExecutor = Executor<E> && requires(E &executor, std::coroutine_handle<> *handles, std::size_t count) {
+    executor.execute_batch(handles, count);
+};
+
+// Resumes waiters directly on the pushing thread
+struct InlineExecutor
+{
+    void execute(std::coroutine_handle<> handle)
+    {
+        handle.resume();
+    }
+};
+
+template <Executor E = InlineExecutor>
+class AsyncQueue
+{
+public:
+    class PopAwaiter
+    {
+    public:
+        explicit PopAwaiter(AsyncQueue &queue) : queue_(queue)
+        {
+        }
+
+        bool await_ready()
+        {
+            /**
+             * Takes an element without suspending if one is available.
+             *
+             * @complexity Time complexity: O(1) amortized.
+             */
+            return seg_queue_pop(queue_.queue_, &value_);
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            /**
+             * Links the awaiting coroutine at the tail of the waiter list.
+             *
+             * The waiter count is raised before the queue is checked again, and `push`
+             * checks the count after publishing its element, so either this check sees the
+             * element or the producer sees the waiter: a wakeup cannot be lost.
+             *
+             * @complexity Time complexity: O(1).
+             *
+             * @return `false` if an element arrived in the meantime and the coroutine
+             *         continues immediately, `true` if it stays suspended.
+             */
+            handle_ = handle;
+            std::lock_guard<std::mutex> lock(queue_.mutex_);
+            queue_.waiter_count_.fetch_add(1);
+            if (seg_queue_pop(queue_.queue_, &value_))
+            {
+                queue_.waiter_count_.fetch_sub(1);
+                return false;
+            }
+            next_ = nullptr;
+            if (queue_.waiters_tail_)
+            {
+                queue_.waiters_tail_->next_ = this;
+            }
+            else
+            {
+                queue_.waiters_head_ = this;
+            }
+            queue_.waiters_tail_ = this;
+            QUEUE_CONTENTION(queue_.contention_, CONTENTION_PARK);
+            QUEUE_TRACE2(async_queue_wait, reinterpret_cast<intptr_t>(&queue_), queue_.waiter_count_.load());
+            return true;
+        }
+
+        int await_resume() const noexcept
+        {
+            return value_;
+        }
+
+    private:
+        friend class AsyncQueue;
+
+        AsyncQueue &queue_;
+        std::coroutine_handle<> handle_;
+        PopAwaiter *next_ = nullptr;
+        int value_ = 0;
+    };
+
+    explicit AsyncQueue(E &executor) : executor_(executor), queue_(seg_queue_create())
+    {
+        /**
+         * Creates an awaitable queue backed by a segmented lock-free queue.
+         *
+         * Consumers `co_await queue.pop()`: if the queue is empty the coroutine suspends
+         * without blocking its thread and is linked into an intrusive waiter list (the
+         * awaiter lives in the coroutine frame, so waiting allocates nothing). Pushes hand
+         * elements to waiters in FIFO order and resume them on `executor`.
+         *
+         * @note The executor must outlive the queue.
+         *
+         * @complexity Time complexity: O(s), where s is `SEG_QUEUE_SEGMENT_SIZE`.
+         *
+         * @param executor Executor used to resume waiting coroutines.
+         */
+        if (!queue_)
+        {
+            throw std::bad_alloc();
+        }
+#if QUEUE_CONTENTION_PROFILE
+        contention_ = contention_profile_create();
+#endif
+    }
+
+    AsyncQueue(const AsyncQueue &) = delete;
+    AsyncQueue &operator=(const AsyncQueue &) = delete;
+
+    ~AsyncQueue()
+    {
+        /**
+         * Frees the queue and every element still stored in it.
+         *
+         * @note No coroutine may still be suspended on the queue.
+         */
+#if DEBUG_MODE
+        if (waiters_head_)
+        {
+            fprintf(stderr, "WARNING: AsyncQueue destroyed with suspended waiters.\n");
+        }
+#endif
+#if QUEUE_CONTENTION_PROFILE
+        contention_profile_free(contention_);
+#endif
+        seg_queue_free(queue_);
+    }
+
+    PopAwaiter pop()
+    {
+        /**
+         * Returns an awaitable that yields the front element of the queue.
+         *
+         * @note The awaiting coroutine must not be destroyed while it is suspended.
+         *
+         * @complexity Time complexity: O(1) amortized.
+         *
+         * @return Awaiter whose `co_await` result is the removed value.
+         */
+        return PopAwaiter(*this);
+    }
+
+    bool try_pop(int &out_value)
+    {
+        /**
+         * Removes the front element without waiting.
+         *
+         * @complexity Time complexity: O(1) amortized.
+         *
+         * @param out_value Reference where the removed value will be stored.
+         * @return `true` if an element was removed, `false` if the queue is empty.
+         */
+        return seg_queue_pop(queue_, &out_value);
+    }
+
+    void push(int data)
+    {
+        /**
+         * Adds the given data at the tail of the queue and wakes a waiter if there is one.
+         *
+         * Without waiters a push is just a lock-free `seg_queue_push`; the waiter list is
+         * only locked when a consumer is suspended.
+         *
+         * @note Safe to call concurrently from any number of threads.
+         *
+         * @complexity Time complexity: O(1) amortized, plus the executor's cost per wakeup.
+         *
+         * @param data The value to store.
+         */
+        seg_queue_push(queue_, data);
+        if (waiter_count_.load() != 0)
+        {
+            wake_waiters();
+        }
+    }
+
+    void push_bulk(const int *data, std::size_t count)
+    {
+        /**
+         * Adds `count` elements at the tail of the queue and wakes the waiters they satisfy.
+         *
+         * The elements are enqueued with `seg_queue_push_bulk`, which reserves their slots
+         * with one fetch-and-add per segment instead of one per element. The waiters are
+         * detached under one lock acquisition and handed to the executor
+         * together (through `execute_batch` when it has one), in groups of at most
+         * `ASYNC_QUEUE_WAKE_BATCH`.
+         *
+         * @note Safe to call concurrently from any number of threads.
+         *
+         * @complexity Time complexity: O(n), where n is `count`.
+         *
+         * @param data Pointer to the values to store.
+         * @param count Number of values.
+         */
+        while (count > 0)
+        {
+            int chunk = count < (std::size_t)INT_MAX ? (int)count : INT_MAX;
+            seg_queue_push_bulk(queue_, data, chunk);
+            data += chunk;
+            count -= (std::size_t)chunk;
+        }
+        if (waiter_count_.load() != 0)
+        {
+            wake_waiters();
+        }
+    }
+
+    bool is_empty()
+    {
+        /**
+         * Checks if the queue is empty.
+         *
+         * @note Under concurrent pushes and pops the result is only a snapshot.
+         *
+         * @complexity Time complexity: O(1).
+         */
+        return seg_queue_is_empty(queue_);
+    }
+
+    bool get_contention(int thread_slot, ContentionStats &out)
+    {
+        /**
+         * Reads the contention counters for one thread slot, or summed over all threads
+         * with `thread_slot` -1.
+         *
+         * Parks count consumers that suspended on an empty queue, unparks the waiters a
+         * push handed an element to (counted on the pushing thread). The remaining
+         * counters come from the underlying segmented queue (`seg_queue_get_contention`).
+         *
+         * @note Parks and unparks are counted when this header is compiled with
+         *       `-DQUEUE_CONTENTION_PROFILE=1`, the other counters when the library is.
+         *
+         * @complexity Time complexity: O(t), where t is the number of thread slots.
+         *
+         * @return `true` if any counters were read, `false` if profiling is compiled out.
+         */
+        bool found = seg_queue_get_contention(queue_, thread_slot, &out);
+#if QUEUE_CONTENTION_PROFILE
+        ContentionStats waits;
+        if (contention_profile_get(contention_, thread_slot, &waits))
+        {
+            out.parks = waits.parks;
+            out.unparks = waits.unparks;
+            found = true;
+        }
+#endif
+        return found;
+    }
+
+private:
+    void wake_waiters()
+    {
+        /**
+         * Pairs suspended waiters with available elements and resumes them.
+         *
+         * Handles are resumed after the lock is released, so a resumed coroutine can push
+         * or pop again right away.
+         *
+         * @complexity Time complexity: O(w), where w is the number of waiters woken.
+         */
+        std::coroutine_handle<> batch[ASYNC_QUEUE_WAKE_BATCH];
+        for (;;)
+        {
+            std::size_t count = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                while (count < ASYNC_QUEUE_WAKE_BATCH && waiters_head_)
+                {
+                    PopAwaiter *waiter = waiters_head_;
+                    if (!seg_queue_pop(queue_, &waiter->value_))
+                    {
+                        break;
+                    }
+                    waiters_head_ = waiter->next_;
+                    if (!waiters_head_)
+                    {
+                        waiters_tail_ = nullptr;
+                    }
+                    waiter_count_.fetch_sub(1);
+                    QUEUE_CONTENTION(contention_, CONTENTION_UNPARK);
+                    batch[count++] = waiter->handle_;
+                }
+            }
+            if (count == 0)
+            {
+                return;
+            }
+            if constexpr (BatchExecutor<E>)
+            {
+                executor_.execute_batch(batch, count);
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    executor_.execute(batch[i]);
+                }
+            }
+            if (count < ASYNC_QUEUE_WAKE_BATCH)
+            {
+                return;
+            }
+        }
+    }
+
+    E &executor_;
+    struct SegQueue *queue_;
+    std::mutex mutex_;
+    std::atomic<std::size_t> waiter_count_{0};
+    PopAwaiter *waiters_head_ = nullptr;
+    PopAwaiter *waiters_tail_ = nullptr;
+#if QUEUE_CONTENTION_PROFILE
+    ContentionProfile *contention_ = nullptr;
+#endif
+};
+
+} // namespace queue
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BATCH_CONTROLLER_H
+#define BATCH_CONTROLLER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Counters describing the batch size decisions of a controller
+struct BatchControllerStats
+{
+    uint64_t batch_size;
+    uint64_t updates;
+    uint64_t grows;
+    uint64_t shrinks;
+    uint64_t holds;
+    uint64_t slo_violations;
+};
+
+// Online batch size tuner; embed it by value and drive it with batch_controller_update
+struct BatchController
+{
+    int min_batch;
+    int max_batch;
+    int batch;
+    uint64_t target_latency_ns;
+    struct BatchControllerStats stats;
+};
+
+QUEUE_API void batch_controller_init(struct BatchController *controller, int min_batch, int max_batch, uint64_t target_latency_ns);
+QUEUE_API int batch_controller_size(const struct BatchController *controller);
+QUEUE_API void batch_controller_update(struct BatchController *controller, size_t backlog, uint64_t latency_ns);
+QUEUE_API void batch_controller_get_stats(const struct BatchController *controller, struct BatchControllerStats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
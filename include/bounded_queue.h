@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include "contention.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+struct BoundedQueue;
+
+QUEUE_API struct BoundedQueue *bounded_queue_create(int capacity);
+QUEUE_API bool bounded_queue_try_push(struct BoundedQueue *queue, int data);
+QUEUE_API bool bounded_queue_try_pop(struct BoundedQueue *queue, int *out_value);
+QUEUE_API int bounded_queue_push_bulk(struct BoundedQueue *queue, const int *values, int count);
+QUEUE_API int bounded_queue_pop_bulk(struct BoundedQueue *queue, int *out_values, int max_count);
+QUEUE_API int bounded_queue_size(struct BoundedQueue *queue);
+QUEUE_API int bounded_queue_capacity(struct BoundedQueue *queue);
+QUEUE_API bool bounded_queue_get_contention(struct BoundedQueue *queue, int thread_slot, struct ContentionStats *out);
+QUEUE_API void bounded_queue_free(struct BoundedQueue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CHUNK_QUEUE_H
+#define CHUNK_QUEUE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Number of elements stored in each chunk of a ChunkQueue
+#define CHUNK_QUEUE_CHUNK_SIZE 1024
+
+// Upper bound of the 32-bit words chunk_codec_encode writes for one chunk
+#define CHUNK_CODEC_MAX_WORDS (CHUNK_QUEUE_CHUNK_SIZE + 3)
+
+// Storage of the full chunks between the head and the tail of the queue
+enum ChunkQueueMode
+{
+    CHUNK_QUEUE_PLAIN,
+    CHUNK_QUEUE_COMPRESSED
+};
+
+struct ChunkQueue;
+
+QUEUE_API struct ChunkQueue *chunk_queue_create(enum ChunkQueueMode mode);
+QUEUE_API void chunk_queue_push(struct ChunkQueue *queue, int data);
+QUEUE_API bool chunk_queue_pop(struct ChunkQueue *queue, int *out_value);
+QUEUE_API bool chunk_queue_peek(struct ChunkQueue *queue, int *out_value);
+QUEUE_API size_t chunk_queue_size(struct ChunkQueue *queue);
+QUEUE_API bool chunk_queue_is_empty(struct ChunkQueue *queue);
+QUEUE_API size_t chunk_queue_memory_usage(struct ChunkQueue *queue);
+QUEUE_API void chunk_queue_free(struct ChunkQueue *queue);
+
+QUEUE_API size_t chunk_codec_encode(const int *values, uint32_t *out_words);
+QUEUE_API void chunk_codec_decode(const uint32_t *words, int *out_values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CONTENTION_H
+#define CONTENTION_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Set QUEUE_CONTENTION_PROFILE to 1 to count contention events in the concurrent queues
+#ifndef QUEUE_CONTENTION_PROFILE
+#define QUEUE_CONTENTION_PROFILE 0
+#endif
+
+// Kinds of contention events a concurrent queue records
+enum ContentionEvent
+{
+    CONTENTION_CAS_FAILURE,
+    CONTENTION_SPIN,
+    CONTENTION_YIELD,
+    CONTENTION_PARK,
+    CONTENTION_UNPARK,
+    CONTENTION_FULL_STALL,
+    CONTENTION_EMPTY_STALL,
+    CONTENTION_EVENTS
+};
+
+// Contention counters of one queue, for one thread or summed over all threads
+struct ContentionStats
+{
+    uint64_t cas_failures;
+    uint64_t spins;
+    uint64_t yields;
+    uint64_t parks;
+    uint64_t unparks;
+    uint64_t full_stalls;
+    uint64_t empty_stalls;
+};
+
+struct ContentionProfile;
+
+QUEUE_API struct ContentionProfile *contention_profile_create(void);
+QUEUE_API void contention_profile_record(struct ContentionProfile *profile, enum ContentionEvent event);
+QUEUE_API bool contention_profile_get(const struct ContentionProfile *profile, int thread_slot, struct ContentionStats *out);
+QUEUE_API void contention_profile_free(struct ContentionProfile *profile);
+
+// Records an event in a queue's profile; expands to nothing unless QUEUE_CONTENTION_PROFILE is set
+#if QUEUE_CONTENTION_PROFILE
+#define QUEUE_CONTENTION(profile, event) contention_profile_record((profile), (event))
+#else
+#define QUEUE_CONTENTION(profile, event) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
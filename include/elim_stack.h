@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ELIM_STACK_H
+#define ELIM_STACK_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include "contention.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Default number of exchange slots in the elimination array
+#define ELIM_STACK_DEFAULT_WIDTH 16
+
+// Number of iterations a push waits in the elimination array for a matching pop
+#define ELIM_STACK_WAIT_SPINS 256
+
+struct ElimStack;
+
+QUEUE_API struct ElimStack *elim_stack_create(int width);
+QUEUE_API void elim_stack_push(struct ElimStack *stack, int data);
+QUEUE_API bool elim_stack_pop(struct ElimStack *stack, int *out_value);
+QUEUE_API bool elim_stack_is_empty(struct ElimStack *stack);
+QUEUE_API bool elim_stack_get_contention(struct ElimStack *stack, int thread_slot, struct ContentionStats *out);
+QUEUE_API void elim_stack_free(struct ElimStack *stack);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Number of retired nodes a thread buffers before trying to advance the epoch
+#define EPOCH_RETIRE_BATCH 64
+
+// Counters describing the memory held back by deferred reclamation
+struct EpochStats
+{
+    uint64_t epoch;
+    uint64_t advances;
+    uint64_t threads;
+    uint64_t retired;
+    uint64_t reclaimed;
+    uint64_t pending;
+    uint64_t pending_bytes;
+    uint64_t list_bytes;
+    uint64_t reclaim_batches;
+    uint64_t total_reclaim_latency_ns;
+    uint64_t max_reclaim_latency_ns;
+};
+
+QUEUE_API void epoch_enter(void);
+QUEUE_API void epoch_exit(void);
+QUEUE_API void epoch_thread_online(void);
+QUEUE_API void epoch_thread_offline(void);
+QUEUE_API void epoch_quiescent(void);
+QUEUE_API void epoch_retire(void *ptr, size_t size, void (*free_fn)(void *));
+QUEUE_API void epoch_reclaim(void);
+QUEUE_API void epoch_get_stats(struct EpochStats *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef FC_QUEUE_H
+#define FC_QUEUE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include "contention.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Operations of a sequential queue that the flat-combining wrapper executes on behalf of other threads.
+// `push_front` and `pop_back` may be NULL for queues that are not double-ended.
+struct SeqQueueOps
+{
+    void (*push)(void *queue, int data);
+    bool (*pop)(void *queue, int *out_value);
+    void (*push_front)(void *queue, int data);
+    bool (*pop_back)(void *queue, int *out_value);
+};
+
+extern QUEUE_API const struct SeqQueueOps linked_list_ops;
+
+struct FCQueue;
+
+QUEUE_API struct FCQueue *fc_queue_create(void *queue, const struct SeqQueueOps *ops);
+QUEUE_API void fc_queue_push(struct FCQueue *fc, int data);
+QUEUE_API bool fc_queue_pop(struct FCQueue *fc, int *out_value);
+QUEUE_API void fc_queue_push_front(struct FCQueue *fc, int data);
+QUEUE_API bool fc_queue_pop_back(struct FCQueue *fc, int *out_value);
+QUEUE_API void fc_queue_execute(struct FCQueue *fc, void (*fn)(void *queue, void *arg), void *arg);
+QUEUE_API bool fc_queue_get_contention(struct FCQueue *fc, int thread_slot, struct ContentionStats *out);
+QUEUE_API void fc_queue_free(struct FCQueue *fc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef HAZARD_H
+#define HAZARD_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Number of hazard pointer slots owned by each thread
+#define HAZARD_SLOTS_PER_THREAD 2
+
+// Minimum number of retired nodes a thread buffers before scanning the hazards
+#define HAZARD_RETIRE_BATCH 64
+
+QUEUE_API void hazard_set(int slot, void *ptr);
+QUEUE_API void hazard_clear(int slot);
+QUEUE_API void hazard_clear_all(void);
+QUEUE_API void hazard_retire(void *ptr, void (*free_fn)(void *));
+QUEUE_API void hazard_scan(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
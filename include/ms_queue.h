@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MS_QUEUE_H
+#define MS_QUEUE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include "contention.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Safe memory reclamation scheme used for nodes unlinked by `ms_queue_pop`
+enum MSQueueReclaim
+{
+    MS_QUEUE_RECLAIM_HAZARD,
+    MS_QUEUE_RECLAIM_EPOCH
+};
+
+struct MSQueue;
+
+QUEUE_API struct MSQueue *ms_queue_create(enum MSQueueReclaim reclaim);
+QUEUE_API void ms_queue_push(struct MSQueue *queue, int data);
+QUEUE_API void ms_queue_push_bulk(struct MSQueue *queue, const int *values, int count);
+QUEUE_API bool ms_queue_pop(struct MSQueue *queue, int *out_value);
+QUEUE_API bool ms_queue_is_empty(struct MSQueue *queue);
+QUEUE_API bool ms_queue_get_contention(struct MSQueue *queue, int thread_slot, struct ContentionStats *out);
+QUEUE_API void ms_queue_free(struct MSQueue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+#include "bounded_queue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Maximum number of stages in a pipeline and of outputs per stage
+#define PIPELINE_MAX_STAGES 16
+#define PIPELINE_MAX_OUTPUTS 8
+
+// Default capacity of the bounded queue in front of each stage
+#define PIPELINE_DEFAULT_QUEUE_CAPACITY 4096
+
+// Default number of values a stage takes from its input queue per call
+#define PIPELINE_DEFAULT_BATCH 64
+
+// CPU argument of pipeline_add_stage for threads that may run anywhere
+#define PIPELINE_NO_CPU -1
+
+// Handle a stage function uses to send values downstream
+struct PipelineEmitter;
+
+// A stage consumes a batch of values from its input queue and emits to its outputs
+typedef void (*PipelineStageFn)(void *context, const int *values, int count, struct PipelineEmitter *emitter);
+
+// Throughput and queue depth of one stage, summed over its threads
+struct PipelineStageStats
+{
+    const char *name;
+    int threads;
+    uint64_t consumed;
+    uint64_t emitted;
+    uint64_t batches;
+    uint64_t full_stalls;
+    uint64_t empty_polls;
+    uint64_t busy_ns;
+    uint64_t elapsed_ns;
+    double throughput;
+    int queue_depth;
+    int queue_capacity;
+};
+
+struct Pipeline;
+
+QUEUE_API struct Pipeline *pipeline_create(int queue_capacity, int batch_size);
+QUEUE_API int pipeline_add_stage(struct Pipeline *pipeline, const char *name, PipelineStageFn fn, void *context,
+                                 int threads, int cpu);
+QUEUE_API int pipeline_connect(struct Pipeline *pipeline, int from_stage, int to_stage);
+QUEUE_API bool pipeline_start(struct Pipeline *pipeline);
+QUEUE_API bool pipeline_push(struct Pipeline *pipeline, int stage, int value);
+QUEUE_API bool pipeline_push_bulk(struct Pipeline *pipeline, int stage, const int *values, int count);
+QUEUE_API void pipeline_emit(struct PipelineEmitter *emitter, int output, int value);
+QUEUE_API void pipeline_close(struct Pipeline *pipeline);
+QUEUE_API void pipeline_wait(struct Pipeline *pipeline);
+QUEUE_API int pipeline_stage_count(struct Pipeline *pipeline);
+QUEUE_API bool pipeline_get_stage_stats(struct Pipeline *pipeline, int stage, struct PipelineStageStats *out);
+QUEUE_API void pipeline_free(struct Pipeline *pipeline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
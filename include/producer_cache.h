@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef PRODUCER_CACHE_H
+#define PRODUCER_CACHE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+#include "ms_queue.h"
+#include "batch_controller.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Default number of values a producer buffers before publishing them in one batch
+#define PRODUCER_CACHE_DEFAULT_CAPACITY 64
+
+// Default bound on how long a buffered value may wait before it is published
+#define PRODUCER_CACHE_DEFAULT_MAX_DELAY_NS 100000ULL
+
+// Counters describing how a producer's batches were published
+struct ProducerCacheStats
+{
+    uint64_t pushes;
+    uint64_t flushes;
+    uint64_t full_flushes;
+    uint64_t timed_flushes;
+    uint64_t explicit_flushes;
+    struct BatchControllerStats batching;
+};
+
+struct ProducerCache;
+
+QUEUE_API struct ProducerCache *producer_cache_create(struct MSQueue *queue, int capacity, uint64_t max_delay_ns);
+QUEUE_API void producer_cache_set_target_latency(struct ProducerCache *cache, uint64_t target_latency_ns);
+QUEUE_API void producer_cache_push(struct ProducerCache *cache, int data);
+QUEUE_API void producer_cache_flush(struct ProducerCache *cache);
+QUEUE_API bool producer_cache_poll(struct ProducerCache *cache);
+QUEUE_API void producer_cache_get_stats(struct ProducerCache *cache, struct ProducerCacheStats *out);
+QUEUE_API void producer_cache_free(struct ProducerCache *cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -28,10 +28,20 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
 
 // Maximum number of registered queues
 #define MAX_QUEUES 100
 
+// Number of elements written or read per block by queue_save and queue_load
+#define QUEUE_CHECKPOINT_BLOCK (256 * 1024)
+
 struct Node
 {
     int data;
@@ -45,16 +55,37 @@ struct LinkedList
     struct Node *tail;
     int size;
     int index;
+    uint64_t pushed;
+    uint64_t popped;
 };
 
-struct LinkedList *queue_create();
-void queue_push(struct LinkedList *list, int data);
-int queue_pop(struct LinkedList *list);
-int queue_search(struct LinkedList *list, int data);
-void queue_print(struct LinkedList *list);
-void queue_free(struct LinkedList *list);
-int queue_size(struct LinkedList *list);
-bool queue_peek(struct LinkedList *list, int *out_value);
-bool queue_is_empty(struct LinkedList *list);
+QUEUE_API struct LinkedList *queue_create();
+QUEUE_API void queue_enable_auto_cleanup(void);
+QUEUE_API void queue_push(struct LinkedList *list, int data);
+QUEUE_API int queue_pop(struct LinkedList *list);
+QUEUE_API void queue_push_front(struct LinkedList *list, int data);
+QUEUE_API int queue_pop_back(struct LinkedList *list);
+QUEUE_API int queue_drain(struct LinkedList *list, int *out_values, int max_count);
+QUEUE_API int queue_search(struct LinkedList *list, int data);
+QUEUE_API void queue_print(struct LinkedList *list);
+QUEUE_API void queue_free(struct LinkedList *list);
+QUEUE_API int queue_size(struct LinkedList *list);
+QUEUE_API size_t queue_memory_usage(struct LinkedList *list);
+QUEUE_API bool queue_peek(struct LinkedList *list, int *out_value);
+QUEUE_API bool queue_is_empty(struct LinkedList *list);
+QUEUE_API bool queue_save(struct LinkedList *list, int fd);
+QUEUE_API struct LinkedList *queue_load(int fd);
+QUEUE_API int queue_save_all(int fd);
+QUEUE_API int queue_load_all(int fd, struct LinkedList **out_lists, int max_lists);
+QUEUE_API int queue_registry(struct LinkedList **out_lists, int max_lists);
+
+#ifdef __cplusplus
+}
+#endif
+
+// Define QUEUE_IMPLEMENTATION in exactly one translation unit to compile the queue into it
+#ifdef QUEUE_IMPLEMENTATION
+#include "queue_impl.h"
+#endif
 
 #endif
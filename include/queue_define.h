@@ -0,0 +1,226 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef QUEUE_DEFINE_H
+#define QUEUE_DEFINE_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "queue_trace.h"
+
+// Capacity policies accepted by QUEUE_DEFINE: a growable heap buffer, or a fixed power-of-two inline buffer.
+// Each expands to a storage kind and a capacity (0 for growable).
+#define QUEUE_GROWABLE QUEUE_DEFINE_GROWABLE, 0
+#define QUEUE_FIXED(capacity) QUEUE_DEFINE_FIXED, (capacity)
+
+// Storage of each kind: only the fixed kind embeds an element array in the struct
+#define QUEUE_DEFINE_GROWABLE_STORAGE(type, capacity)
+#define QUEUE_DEFINE_FIXED_STORAGE(type, capacity) type inline_items[capacity];
+#define QUEUE_DEFINE_GROWABLE_BUFFER(q) ((q)->items)
+#define QUEUE_DEFINE_FIXED_BUFFER(q) ((q)->inline_items)
+
+// Initial capacity of a growable queue, doubled whenever it is full
+#define QUEUE_DEFINE_INITIAL_CAPACITY 16
+
+// Compile-time check usable at file scope from both C11 and C++
+#ifdef __cplusplus
+#define QUEUE_DEFINE_STATIC_ASSERT(condition, message) static_assert(condition, message)
+#else
+#define QUEUE_DEFINE_STATIC_ASSERT(condition, message) _Static_assert(condition, message)
+#endif
+
+/*
+ * QUEUE_DEFINE(name, type, capacity_policy) expands to a ring-buffer queue of `type`
+ * named `struct name` and to `static inline` operations prefixed with `name_`:
+ *
+ *   bool name_init(struct name *q);
+ *   void name_destroy(struct name *q);
+ *   bool name_push(struct name *q, type value);
+ *   bool name_push_front(struct name *q, type value);
+ *   bool name_pop(struct name *q, type *out_value);
+ *   bool name_pop_back(struct name *q, type *out_value);
+ *   bool name_peek(const struct name *q, type *out_value);
+ *   size_t name_size(const struct name *q);
+ *   bool name_is_empty(const struct name *q);
+ *   bool name_is_full(const struct name *q);
+ *
+ * Elements are stored by value, so no `void *` indirection or runtime element size is
+ * involved and the compiler can inline every operation into the caller. The capacity
+ * policy is a compile-time constant: with QUEUE_FIXED(n) the buffer lives inside the
+ * struct, pushes fail when it is full and index wrapping uses the constant mask `n - 1`;
+ * with QUEUE_GROWABLE the buffer is heap-allocated and doubles when full, and the struct
+ * holds no inline array.
+ */
+#define QUEUE_DEFINE(name, type, capacity_policy) QUEUE_DEFINE_POLICY(name, type, capacity_policy)
+
+// Receives the policy split into its storage kind and capacity
+#define QUEUE_DEFINE_POLICY(name, type, kind, capacity_policy)                                      \
+    QUEUE_DEFINE_STATIC_ASSERT(((capacity_policy) & ((capacity_policy) - 1)) == 0,                  \
+                               "QUEUE_FIXED capacity of " #name " must be a power of two");         \
+                                                                                                    \
+    struct name                                                                                     \
+    {                                                                                               \
+        type *items;                                                                                \
+        size_t head;                                                                                \
+        size_t tail;                                                                                \
+        size_t capacity;                                                                            \
+        kind##_STORAGE(type, capacity_policy)                                                       \
+    };                                                                                              \
+                                                                                                    \
+    static inline type *name##_buffer(struct name *q)                                               \
+    {                                                                                               \
+        return kind##_BUFFER(q);                                                                    \
+    }                                                                                               \
+                                                                                                    \
+    static inline size_t name##_mask(const struct name *q)                                          \
+    {                                                                                               \
+        return (capacity_policy) > 0 ? (size_t)(capacity_policy) - 1 : q->capacity - 1;             \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_init(struct name *q)                                                  \
+    {                                                                                               \
+        q->head = 0;                                                                                \
+        q->tail = 0;                                                                                \
+        q->items = NULL;                                                                            \
+        q->capacity = (capacity_policy) > 0 ? (size_t)(capacity_policy)                             \
+                                            : QUEUE_DEFINE_INITIAL_CAPACITY;                        \
+        if ((capacity_policy) > 0)                                                                  \
+        {                                                                                           \
+            return true;                                                                            \
+        }                                                                                           \
+        q->items = (type *)malloc(q->capacity * sizeof(type));                                      \
+        return q->items != NULL;                                                                    \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_destroy(struct name *q)                                               \
+    {                                                                                               \
+        free(q->items);                                                                             \
+        q->items = NULL;                                                                            \
+        q->head = 0;                                                                                \
+        q->tail = 0;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline size_t name##_size(const struct name *q)                                          \
+    {                                                                                               \
+        return q->tail - q->head;                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_is_empty(const struct name *q)                                        \
+    {                                                                                               \
+        return q->tail == q->head;                                                                  \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_is_full(const struct name *q)                                         \
+    {                                                                                               \
+        return name##_size(q) == name##_mask(q) + 1;                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_grow(struct name *q)                                                  \
+    {                                                                                               \
+        size_t capacity = q->capacity * 2;                                                          \
+        type *items = (type *)malloc(capacity * sizeof(type));                                      \
+        if (items == NULL)                                                                          \
+        {                                                                                           \
+            return false;                                                                           \
+        }                                                                                           \
+        size_t size = name##_size(q);                                                               \
+        size_t first = q->head & (q->capacity - 1);                                                 \
+        size_t chunk = size < q->capacity - first ? size : q->capacity - first;                     \
+        memcpy(items, q->items + first, chunk * sizeof(type));                                      \
+        memcpy(items + chunk, q->items, (size - chunk) * sizeof(type));                             \
+        free(q->items);                                                                             \
+        q->items = items;                                                                           \
+        q->capacity = capacity;                                                                     \
+        q->head = 0;                                                                                \
+        q->tail = size;                                                                             \
+        QUEUE_TRACE3(queue_define_grow, (intptr_t)q, capacity / 2, capacity);                       \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_reserve_one(struct name *q)                                           \
+    {                                                                                               \
+        if (!name##_is_full(q))                                                                     \
+        {                                                                                           \
+            return true;                                                                            \
+        }                                                                                           \
+        return (capacity_policy) == 0 && name##_grow(q);                                            \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_push(struct name *q, type value)                                      \
+    {                                                                                               \
+        if (!name##_reserve_one(q))                                                                 \
+        {                                                                                           \
+            return false;                                                                           \
+        }                                                                                           \
+        name##_buffer(q)[q->tail & name##_mask(q)] = value;                                         \
+        q->tail++;                                                                                  \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_push_front(struct name *q, type value)                                \
+    {                                                                                               \
+        if (!name##_reserve_one(q))                                                                 \
+        {                                                                                           \
+            return false;                                                                           \
+        }                                                                                           \
+        q->head--;                                                                                  \
+        name##_buffer(q)[q->head & name##_mask(q)] = value;                                         \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_pop(struct name *q, type *out_value)                                  \
+    {                                                                                               \
+        if (name##_is_empty(q))                                                                     \
+        {                                                                                           \
+            return false;                                                                           \
+        }                                                                                           \
+        *out_value = name##_buffer(q)[q->head & name##_mask(q)];                                    \
+        q->head++;                                                                                  \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_pop_back(struct name *q, type *out_value)                             \
+    {                                                                                               \
+        if (name##_is_empty(q))                                                                     \
+        {                                                                                           \
+            return false;                                                                           \
+        }                                                                                           \
+        q->tail--;                                                                                  \
+        *out_value = name##_buffer(q)[q->tail & name##_mask(q)];                                    \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_peek(const struct name *q, type *out_value)                           \
+    {                                                                                               \
+        if (name##_is_empty(q))                                                                     \
+        {                                                                                           \
+            return false;                                                                           \
+        }                                                                                           \
+        *out_value = name##_buffer((struct name *)q)[q->head & name##_mask(q)];                     \
+        return true;                                                                                \
+    }
+
+#endif
@@ -0,0 +1,1099 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Implementation of the LinkedList queue.
+ *
+ * This file is not meant to be included directly. It is compiled into libqueue.a by
+ * src/queue.c, or pulled into a single translation unit by defining QUEUE_IMPLEMENTATION
+ * before including queue.h, which lets the compiler inline the O(1) operations into the
+ * caller.
+ */
+
+#ifndef QUEUE_IMPL_H
+#define QUEUE_IMPL_H
+
+#include "queue.h"
+#include "queue_trace.h"
+#include <stdint.h>
+#include <string.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <errno.h>
+#include <unistd.h>
+
+// Set QUEUE_AUTO_CLEANUP to 1 to register the atexit sweep from a constructor, before `main`
+#ifndef QUEUE_AUTO_CLEANUP
+#define QUEUE_AUTO_CLEANUP 0
+#endif
+
+// Checkpoint format: a header, `count` native-endian ints in blocks, then a Fletcher-64 checksum
+#define QUEUE_CHECKPOINT_MAGIC 0x50434B51u
+#define QUEUE_CHECKPOINT_ALL_MAGIC 0x41434B51u
+#define QUEUE_CHECKPOINT_VERSION 1u
+
+struct QueueCheckpointHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t count;
+    uint32_t block_size;
+    uint32_t reserved;
+};
+
+// Stops the metrics sampler before the sweep; a weak reference, so it is NULL when queue_metrics.o is not linked
+extern void queue_metrics_stop(void) __attribute__((weak));
+
+static struct LinkedList *registered_queues[MAX_QUEUES] = {NULL};
+static int next_index = 0;
+static bool cleanup_registered = false;
+
+static inline void queue_count(uint64_t *counter, uint64_t amount)
+{
+    /**
+     * Adds `amount` to one of the list's operation counters.
+     *
+     * Only the thread that owns the list writes its counters, so a relaxed load and store
+     * suffice (a plain add on common targets). They let the metrics sampler read the
+     * counters from another thread without locking the list.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + amount, __ATOMIC_RELAXED);
+}
+
+struct LinkedList *queue_create()
+{
+    /**
+     * Allocates and initializes a new linked list structure.
+     *
+     * The function creates a new `LinkedList` instance, assigns it a unique index,
+     * and sets all its pointers to NULL. It logs an error message and returns NULL
+     * if memory allocation fails or the maximum number of lists (`MAX_QUEUES`) is exceeded.
+     *
+     * @note The created list must be managed and freed using `queue_free` to avoid memory leaks.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @return Pointer to the newly created `LinkedList` structure, or NULL if creation fails.
+     */
+    if (next_index >= MAX_QUEUES)
+    {
+        fprintf(stderr, "ERROR: Cannot create more than %d lists.\n", MAX_QUEUES);
+        return NULL;
+    }
+
+    struct LinkedList *list = (struct LinkedList *)malloc(sizeof(struct LinkedList));
+    if (!list)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for LinkedList.\n");
+        return NULL;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->index = next_index;
+    list->pushed = 0;
+    list->popped = 0;
+    next_index++;
+    QUEUE_TRACE1(queue_create, list->index);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Linked list (QUEUE) initialized with index %d.\n", list->index);
+#endif
+    return list;
+}
+
+static void cleanup_linked_list(void)
+{
+    /**
+     * Frees all registered linked lists and resets internal state.
+     *
+     * This function is registered with `atexit` by `queue_enable_auto_cleanup` to be executed at program termination.
+     * It iterates over all registered linked lists, frees their memory, and sets their pointers to NULL.
+     * If no lists are registered, it exits without performing any operations.
+     *
+     * @note This function is static and cannot be called directly by external modules.
+     *       It ensures that all linked lists created during program execution are safely freed.
+     * @note If the metrics sampler is linked in, it is stopped first, so it never reads a
+     *       list being freed, whatever order `queue_metrics_start` and
+     *       `queue_enable_auto_cleanup` were called in.
+     *
+     * @complexity Time complexity: O(n * m), where n is the number of lists and m is the number of nodes per list.
+     */
+#if DEBUG_MODE
+    fprintf(stderr, "DEBUG: Starting cleanup_linked_list\n");
+#endif
+    if (queue_metrics_stop)
+    {
+        queue_metrics_stop();
+    }
+    for (int i = 0; i < next_index; i++)
+    {
+        if (registered_queues[i] != NULL)
+        {
+            if ((registered_queues[i]->head != NULL) || (registered_queues[i]->tail != NULL))
+            {
+                queue_free(registered_queues[i]);
+            }
+            free(registered_queues[i]);
+            registered_queues[i] = NULL;
+        }
+    }
+    next_index = 0;
+    fprintf(stderr, "INFO: All QUEUES have been freed.\n");
+}
+
+void queue_enable_auto_cleanup(void)
+{
+    /**
+     * Registers the `cleanup_linked_list` function for automatic execution.
+     *
+     * This function uses the `atexit` mechanism to ensure that `cleanup_linked_list`
+     * is called at program termination, freeing every registered QUEUE. The sweep is
+     * opt-in: processes that link the library but never call this function do no work
+     * at startup or exit and never touch the registry. Calling it more than once has no
+     * further effect.
+     *
+     * @note Call it from a single thread, typically at the start of `main`.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    if (cleanup_registered)
+    {
+        return;
+    }
+    cleanup_registered = true;
+    atexit(cleanup_linked_list);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Automatic cleanup registered. All QUEUES will be freed at program termination.\n");
+#endif
+}
+
+#if QUEUE_AUTO_CLEANUP
+__attribute__((constructor)) static void register_cleanup()
+{
+    /**
+     * Enables the automatic cleanup before `main` when the library is built with
+     * `-DQUEUE_AUTO_CLEANUP=1`, restoring the behaviour of earlier versions.
+     *
+     * @note This function is static and cannot be called directly by external modules.
+     *       It is executed automatically before the `main` function.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    queue_enable_auto_cleanup();
+}
+#endif
+
+void queue_print(struct LinkedList *list)
+{
+    /**
+     * Prints the elements of the doubly linked list from head to tail.
+     * This is an internal function used for debugging purposes and cannot
+     * be accessed directly by external modules or users.
+     *
+     * The function indicates the head and tail nodes explicitly. If the list
+     * is empty, it prints a message stating so.
+     *
+     * @note This function is declared as `static`, making it accessible only
+     *       within `linked_list.c`. It is typically called by other functions
+     *       in this file for internal debugging.
+     *
+     * @complexity Time complexity: O(n), where n is the number of nodes in the list.
+     *
+     * @param list Pointer to the LinkedList structure.
+     */
+    if (list->head == NULL)
+    {
+        fprintf(stderr, "QUEUE is empty.\n");
+        return;
+    }
+    fprintf(stderr, "[QUEUE %d]  --->  ", list->index);
+    if (list->head == list->tail)
+    {
+        fprintf(stderr, "(HEAD) [ %d ] (TAIL)\n", list->head->data);
+        return;
+    }
+
+    struct Node *iterator = list->head;
+    while (iterator != NULL)
+    {
+        if (iterator == list->head)
+        {
+            fprintf(stderr, "(HEAD) [ %d ] ---> ", iterator->data);
+        }
+        else if (iterator == list->tail)
+        {
+            fprintf(stderr, "[ %d ] (TAIL)\n", iterator->data);
+        }
+        else
+        {
+            fprintf(stderr, "[ %d ] ---> ", iterator->data);
+        }
+        iterator = iterator->next;
+    }
+}
+
+static void initialize_linked_list(struct LinkedList *list, int data)
+{
+    /**
+     * Initializes a doubly linked list with a single node containing the specified data.
+     *
+     * This function allocates memory for a new node and sets it as the head and tail of the list.
+     * The list is also registered for cleanup during program termination. If the list is already
+     * initialized, it logs a message and returns without modifying the existing list.
+     *
+     * @note The function exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the `LinkedList` structure to be initialized.
+     * @param data The value to store in the newly created node.
+     */
+    if (list->head != NULL)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "INFO: QUEUE already initialized.\n");
+#endif
+        return;
+    }
+    struct Node *new_node = (struct Node *)malloc(sizeof(struct Node));
+    if (new_node == NULL)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed in initialize_linked_list(). Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+    new_node->data = data;
+    new_node->next = NULL;
+    new_node->previous = NULL;
+
+    list->head = new_node;
+    list->tail = new_node;
+    list->size = 1;
+    __atomic_store_n(&registered_queues[list->index], list, __ATOMIC_RELEASE);
+}
+
+void queue_push(struct LinkedList *list, int data)
+{
+    /**
+     * Adds a new node with the given data at the end of the doubly linked list.
+     * If the list is empty, it initializes the list using `initialize_linked_list`.
+     * Otherwise, it appends the new node to the end of the list.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @param data The value to store in the newly created node.
+     */
+    if (!list)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return;
+    }
+    if (list->head == NULL)
+    {
+        initialize_linked_list(list, data);
+    }
+    else
+    {
+        struct Node *new_node = (struct Node *)malloc(sizeof(struct Node));
+        if (new_node == NULL)
+        {
+            fprintf(stderr, "ERROR: Memory allocation failed in push(). Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+        new_node->data = data;
+        new_node->next = NULL;
+        new_node->previous = list->tail;
+
+        list->tail->next = new_node;
+        list->tail = new_node;
+        list->size++;
+    }
+    queue_count(&list->pushed, 1);
+    QUEUE_TRACE3(queue_push, list->index, data, list->size);
+#if DEBUG_MODE
+    fprintf(stderr, "PUSH %d:   ", data);
+    queue_print(list);
+#endif
+}
+
+int queue_pop(struct LinkedList *list)
+{
+    /**
+     * Removes and returns the value of the first node in the doubly linked list.
+     * If the list is empty, it returns -1. The function also updates the `head`
+     * and `tail` pointers in the LinkedList structure as necessary.
+     *
+     * @note Ensure the list is not empty before calling this function.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @return The value of the removed node, or -1 if the list is empty.
+     */
+    if (!list || list->head == NULL)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop from an empty or NULL QUEUE.\n");
+#endif
+        return -1;
+    }
+
+    struct Node *temp_head = list->head;
+    int data = list->head->data; // perguntar isso
+
+    if (list->head->next == NULL)
+    {
+        list->head = NULL;
+        list->tail = NULL;
+    }
+    else
+    {
+        list->head = temp_head->next;
+        list->head->previous = NULL;
+    }
+
+    free(temp_head);
+    list->size--;
+    queue_count(&list->popped, 1);
+    QUEUE_TRACE3(queue_pop, list->index, data, list->size);
+
+#if DEBUG_MODE
+    fprintf(stderr, "POP  %d:   ", data);
+    queue_print(list);
+#endif
+    return data;
+}
+
+void queue_push_front(struct LinkedList *list, int data)
+{
+    /**
+     * Adds a new node with the given data at the front of the doubly linked list.
+     * If the list is empty, it initializes the list using `initialize_linked_list`.
+     * Otherwise, it links the new node before the current head.
+     *
+     * This is the inverse of `queue_pop`: an element that was popped can be put back
+     * at the front without rebuilding the queue.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @param data The value to store in the newly created node.
+     */
+    if (!list)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return;
+    }
+    if (list->head == NULL)
+    {
+        initialize_linked_list(list, data);
+    }
+    else
+    {
+        struct Node *new_node = (struct Node *)malloc(sizeof(struct Node));
+        if (new_node == NULL)
+        {
+            fprintf(stderr, "ERROR: Memory allocation failed in push_front(). Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+        new_node->data = data;
+        new_node->next = list->head;
+        new_node->previous = NULL;
+
+        list->head->previous = new_node;
+        list->head = new_node;
+        list->size++;
+    }
+    queue_count(&list->pushed, 1);
+    QUEUE_TRACE3(queue_push_front, list->index, data, list->size);
+#if DEBUG_MODE
+    fprintf(stderr, "PUSHF %d:  ", data);
+    queue_print(list);
+#endif
+}
+
+int queue_pop_back(struct LinkedList *list)
+{
+    /**
+     * Removes and returns the value of the last node in the doubly linked list.
+     * If the list is empty, it returns -1. The function also updates the `head`
+     * and `tail` pointers in the LinkedList structure as necessary.
+     *
+     * Together with `queue_push` it lets the list be used as a stack, and together
+     * with `queue_push_front` and `queue_pop` as a double-ended queue.
+     *
+     * @note Ensure the list is not empty before calling this function.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @return The value of the removed node, or -1 if the list is empty.
+     */
+    if (!list || list->tail == NULL)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop from an empty or NULL QUEUE.\n");
+#endif
+        return -1;
+    }
+
+    struct Node *temp_tail = list->tail;
+    int data = temp_tail->data;
+
+    if (temp_tail->previous == NULL)
+    {
+        list->head = NULL;
+        list->tail = NULL;
+    }
+    else
+    {
+        list->tail = temp_tail->previous;
+        list->tail->next = NULL;
+    }
+
+    free(temp_tail);
+    list->size--;
+    queue_count(&list->popped, 1);
+    QUEUE_TRACE3(queue_pop_back, list->index, data, list->size);
+
+#if DEBUG_MODE
+    fprintf(stderr, "POPB %d:   ", data);
+    queue_print(list);
+#endif
+    return data;
+}
+
+int queue_drain(struct LinkedList *list, int *out_values, int max_count)
+{
+    /**
+     * Removes up to `max_count` nodes from the front of the doubly linked list and stores
+     * their values, in order, in `out_values`.
+     *
+     * This is the bulk form of `queue_pop`: the list is relinked once for the whole batch
+     * instead of once per element, which lets consumers such as I/O stages fill a
+     * buffer in a single call.
+     *
+     * @complexity Time complexity: O(k), where k is the number of removed nodes.
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @param out_values Array with room for at least `max_count` values.
+     * @param max_count Maximum number of values to remove.
+     * @return The number of values removed, 0 if the list is empty or NULL.
+     */
+    if (!list || !out_values || max_count <= 0)
+    {
+        return 0;
+    }
+
+    struct Node *iterator = list->head;
+    int count = 0;
+    while (iterator != NULL && count < max_count)
+    {
+        struct Node *temp = iterator;
+        out_values[count++] = temp->data;
+        iterator = iterator->next;
+        free(temp);
+    }
+
+    list->head = iterator;
+    if (iterator == NULL)
+    {
+        list->tail = NULL;
+    }
+    else
+    {
+        iterator->previous = NULL;
+    }
+    list->size -= count;
+    queue_count(&list->popped, (uint64_t)count);
+    QUEUE_TRACE3(queue_drain, list->index, count, list->size);
+
+#if DEBUG_MODE
+    fprintf(stderr, "DRAIN %d:  ", count);
+    queue_print(list);
+#endif
+    return count;
+}
+
+int queue_search(struct LinkedList *list, int data)
+{
+    /**
+     * Searches for a value in the doubly linked list and returns its position (1-based index).
+     * If the value is found, the position is returned. Otherwise, it prints a message
+     * indicating that the value was not found and returns -1.
+     *
+     * @note The search is performed sequentially from head to tail.
+     *
+     * @complexity Time complexity: O(n), where n is the number of nodes in the list.
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @param data The value to search for in the list.
+     * @return The position of the value in the list (1-based), or -1 if not found.
+     */
+    if (list->head == NULL)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "INFO: QUEUE is empty. Cannot search for data.\n");
+#endif
+        return -1;
+    }
+
+    struct Node *iterator = list->head;
+    int position = 1;
+
+    while (iterator != NULL)
+    {
+        if (iterator->data == data)
+        {
+#if DEBUG_MODE
+            fprintf(stderr, "DEBUG: Data %d found at position %d.\n", data, position);
+#endif
+            return position;
+        }
+        iterator = iterator->next;
+        position++;
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "DEBUG: Value %d NOT found in the QUEUE after traversing %d elements\n", data, position - 1);
+#endif
+    return -1;
+}
+
+void queue_free(struct LinkedList *list)
+{
+    /**
+     * Frees all memory associated with the doubly linked list and sets
+     * the `head` and `tail` pointers in the `LinkedList` structure to NULL.
+     *
+     * If the list has already been freed or is empty, the function logs a message
+     * and skips the operation to prevent errors such as double free. After calling
+     * this function, the list will be empty and cannot be used without reinitialization.
+     *
+     * @note The function ensures that all nodes in the list are freed before resetting the list.
+     * @note Discarded elements are counted in `popped`, so `pushed - popped` stays the depth.
+     *
+     * @complexity Time complexity: O(n), where n is the number of nodes in the list.
+     *
+     * @param list Pointer to the `LinkedList` structure. The list must be properly
+     *             initialized before being passed to this function.
+     */
+    if (!list || list->head == NULL)
+    {
+        fprintf(stderr, "INFO: QUEUE is already empty or NULL. Skipping free.\n");
+        return;
+    }
+
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Freeing QUEUE at index %d.\n", list->index);
+#endif
+
+    struct Node *iterator = list->head;
+    while (iterator != NULL)
+    {
+        struct Node *temp = iterator;
+        iterator = iterator->next;
+        free(temp);
+    }
+
+    QUEUE_TRACE3(queue_free, list->index, list->size, 0);
+    queue_count(&list->popped, (uint64_t)list->size);
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: All nodes in the QUEUE %d have been freed.\n", list->index);
+#endif
+}
+
+int queue_size(struct LinkedList *list)
+{
+    /**
+     * Retrieves the size of the linked list.
+     *
+     * This function returns the current number of elements in the linked list.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @return The size of the linked list.
+     */
+    if (!list || list->head == NULL)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "INFO: Attempt to get size of an empty or NULL QUEUE.\n");
+#endif
+        return 0;
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "DEBUG: Current size of the [QUEUE %d]: %d.\n", list->index, list->size);
+#endif
+    return list->size;
+}
+
+static size_t queue_allocation_size(void *block, size_t requested)
+{
+    /**
+     * Returns the heap bytes an allocation of `requested` bytes occupies.
+     *
+     * With glibc this is the chunk the allocator carved out: the usable size plus the
+     * size word in front of it. Elsewhere the allocator's rounding is unknown and the
+     * requested size is returned.
+     *
+     * @complexity Time complexity: O(1).
+     */
+#if defined(__GLIBC__)
+    return block ? malloc_usable_size(block) + sizeof(size_t) : requested;
+#else
+    (void)block;
+    return requested;
+#endif
+}
+
+size_t queue_memory_usage(struct LinkedList *list)
+{
+    /**
+     * Returns the heap bytes held by the queue: the `LinkedList` structure and one
+     * `Node` per element, including the allocator's per-allocation header and rounding.
+     *
+     * Every element is a separate `malloc` of `sizeof(struct Node)`, so one node is
+     * measured and multiplied by the size. On 64-bit glibc a node occupies 32 bytes
+     * to store a 4-byte `int`.
+     *
+     * @note Without glibc the allocator overhead cannot be queried and only the
+     *       requested sizes are counted.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @return The bytes held, or 0 if the list pointer is NULL.
+     */
+    if (!list)
+    {
+        return 0;
+    }
+    size_t node_bytes = queue_allocation_size(list->head, sizeof(struct Node));
+    return queue_allocation_size(list, sizeof(struct LinkedList)) + (size_t)list->size * node_bytes;
+}
+
+bool queue_peek(struct LinkedList *list, int *out_value)
+{
+    /**
+     * Retrieves the front element of the queue without removing it.
+     *
+     * This function checks if the queue is empty and, if not, retrieves
+     * the value of the first element (head) without dequeuing it.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @param out_value Pointer to an integer where the front element's value will be stored.
+     * @return `true` if the operation is successful and the value is retrieved,
+     *         `false` if the queue is empty or the list pointer is NULL.
+     */
+    if (list == NULL || list->head == NULL)
+    {
+        fprintf(stderr, "ERROR: QUEUE %d is Empty.\n", list->index);
+        return false;
+    }
+    *out_value = list->head->data;
+    return true;
+}
+
+bool queue_is_empty(struct LinkedList *list)
+{
+    /**
+     * Checks if the queue is empty.
+     *
+     * This function determines whether the queue contains any elements.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @return `true` if the queue is empty or the list pointer is NULL, `false` otherwise.
+     */
+    return (list == NULL || list->size == 0);
+}
+
+static bool queue_write_all(int fd, const void *data, size_t length)
+{
+    /**
+     * Writes `length` bytes to `fd`, retrying after short writes and interruptions.
+     *
+     * @complexity Time complexity: O(length).
+     *
+     * @return `true` if every byte was written, `false` on error.
+     */
+    const char *cursor = (const char *)data;
+    while (length > 0)
+    {
+        ssize_t written = write(fd, cursor, length);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        cursor += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static bool queue_read_all(int fd, void *data, size_t length)
+{
+    /**
+     * Reads exactly `length` bytes from `fd`, retrying after short reads and interruptions.
+     *
+     * @complexity Time complexity: O(length).
+     *
+     * @return `true` if every byte was read, `false` on error or end of file.
+     */
+    char *cursor = (char *)data;
+    while (length > 0)
+    {
+        ssize_t received = read(fd, cursor, length);
+        if (received < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        if (received == 0)
+        {
+            return false;
+        }
+        cursor += received;
+        length -= (size_t)received;
+    }
+    return true;
+}
+
+static void queue_checksum_update(uint64_t *sum1, uint64_t *sum2, const int *values, size_t count)
+{
+    /**
+     * Adds `count` values to a Fletcher-64 checksum over 32-bit words.
+     *
+     * The modulo is taken once per 1024 words instead of once per word; the partial sums
+     * cannot overflow 64 bits within such a run.
+     *
+     * @complexity Time complexity: O(count).
+     */
+    while (count > 0)
+    {
+        size_t run = count < 1024 ? count : 1024;
+        for (size_t i = 0; i < run; i++)
+        {
+            *sum1 += (uint32_t)values[i];
+            *sum2 += *sum1;
+        }
+        *sum1 %= 0xFFFFFFFFu;
+        *sum2 %= 0xFFFFFFFFu;
+        values += run;
+        count -= run;
+    }
+}
+
+bool queue_save(struct LinkedList *list, int fd)
+{
+    /**
+     * Writes a checkpoint of the queue to the file descriptor `fd`.
+     *
+     * The checkpoint is a streaming binary format: a header with a magic number, format
+     * version, element count and block size, the elements as native-endian `int` values,
+     * and a Fletcher-64 checksum of the payload. Elements are gathered into blocks of
+     * `QUEUE_CHECKPOINT_BLOCK` values and written with one `write` per block, so the cost
+     * is dominated by walking the list rather than by syscalls or formatting.
+     *
+     * @note The queue is not modified. `fd` may be a file, pipe or socket.
+     *
+     * @complexity Time complexity: O(n), where n is the number of elements in the list.
+     *
+     * @param list Pointer to the LinkedList structure.
+     * @param fd File descriptor open for writing.
+     * @return `true` if the checkpoint was written, `false` on error.
+     */
+    if (!list || fd < 0)
+    {
+        fprintf(stderr, "ERROR: Attempt to save a NULL QUEUE or to an invalid file descriptor.\n");
+        return false;
+    }
+    int *block = (int *)malloc(QUEUE_CHECKPOINT_BLOCK * sizeof(int));
+    if (!block)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed in queue_save().\n");
+        return false;
+    }
+
+    struct QueueCheckpointHeader header = {QUEUE_CHECKPOINT_MAGIC, QUEUE_CHECKPOINT_VERSION, (uint64_t)list->size,
+                                           QUEUE_CHECKPOINT_BLOCK, 0};
+    bool ok = queue_write_all(fd, &header, sizeof(header));
+
+    uint64_t sum1 = 0;
+    uint64_t sum2 = 0;
+    struct Node *iterator = list->head;
+    while (ok && iterator != NULL)
+    {
+        size_t count = 0;
+        while (iterator != NULL && count < QUEUE_CHECKPOINT_BLOCK)
+        {
+            block[count++] = iterator->data;
+            iterator = iterator->next;
+        }
+        queue_checksum_update(&sum1, &sum2, block, count);
+        ok = queue_write_all(fd, block, count * sizeof(int));
+    }
+    uint64_t checksum = (sum2 << 32) | sum1;
+    ok = ok && queue_write_all(fd, &checksum, sizeof(checksum));
+    int error = errno;
+    free(block);
+
+    if (!ok)
+    {
+        fprintf(stderr, "ERROR: Writing the checkpoint of QUEUE %d failed: %s.\n", list->index, strerror(error));
+        return false;
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Saved %d elements of QUEUE %d.\n", list->size, list->index);
+#endif
+    return true;
+}
+
+static void queue_discard(struct LinkedList *list)
+{
+    /**
+     * Destroys a queue that was created internally but is not handed to the caller: frees
+     * its nodes and the structure, and removes it from the registry so the exit sweep,
+     * `queue_registry` and `queue_save_all` no longer see it.
+     *
+     * If it was the most recently created queue, its index is given back as well.
+     *
+     * @complexity Time complexity: O(n), where n is the number of elements in the list.
+     */
+    if (list->head != NULL)
+    {
+        queue_free(list);
+    }
+    __atomic_store_n(&registered_queues[list->index], NULL, __ATOMIC_RELEASE);
+    if (list->index == next_index - 1)
+    {
+        next_index--;
+    }
+    free(list);
+}
+
+struct LinkedList *queue_load(int fd)
+{
+    /**
+     * Reads a checkpoint written by `queue_save` from `fd` into a new queue.
+     *
+     * The payload is read in blocks of at most `QUEUE_CHECKPOINT_BLOCK` values and verified
+     * against the trailing checksum before the queue is returned. The block size recorded
+     * in the header is not trusted for the allocation, so a corrupted header cannot request
+     * a huge buffer before the checksum is checked.
+     *
+     * @note The returned queue is created with `queue_create` and follows its rules.
+     *
+     * @complexity Time complexity: O(n), where n is the number of elements in the checkpoint.
+     *
+     * @param fd File descriptor open for reading, positioned at the start of a checkpoint.
+     * @return Pointer to the restored `LinkedList`, or NULL if the checkpoint is truncated,
+     *         corrupted or of an unknown format.
+     */
+    struct QueueCheckpointHeader header;
+    if (fd < 0 || !queue_read_all(fd, &header, sizeof(header)))
+    {
+        fprintf(stderr, "ERROR: Cannot read the checkpoint header.\n");
+        return NULL;
+    }
+    if (header.magic != QUEUE_CHECKPOINT_MAGIC || header.version != QUEUE_CHECKPOINT_VERSION ||
+        header.block_size == 0 || header.count > (uint64_t)INT32_MAX)
+    {
+        fprintf(stderr, "ERROR: Not a QUEUE checkpoint or unsupported version.\n");
+        return NULL;
+    }
+
+    size_t block_size = header.block_size < QUEUE_CHECKPOINT_BLOCK ? header.block_size : QUEUE_CHECKPOINT_BLOCK;
+    block_size = header.count < block_size ? (size_t)header.count : block_size;
+    int *block = (int *)malloc((block_size ? block_size : 1) * sizeof(int));
+    struct LinkedList *list = block ? queue_create() : NULL;
+    if (!list)
+    {
+        free(block);
+        return NULL;
+    }
+
+    uint64_t sum1 = 0;
+    uint64_t sum2 = 0;
+    uint64_t remaining = header.count;
+    bool ok = true;
+    while (ok && remaining > 0)
+    {
+        size_t count = remaining < block_size ? (size_t)remaining : block_size;
+        ok = queue_read_all(fd, block, count * sizeof(int));
+        if (ok)
+        {
+            queue_checksum_update(&sum1, &sum2, block, count);
+            for (size_t i = 0; i < count; i++)
+            {
+                queue_push(list, block[i]);
+            }
+            remaining -= count;
+        }
+    }
+    uint64_t checksum = 0;
+    ok = ok && queue_read_all(fd, &checksum, sizeof(checksum));
+    free(block);
+
+    if (!ok || checksum != ((sum2 << 32) | sum1))
+    {
+        fprintf(stderr, "ERROR: QUEUE checkpoint is %s.\n", ok ? "corrupted" : "truncated");
+        queue_discard(list);
+        return NULL;
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Loaded %d elements into QUEUE %d.\n", list->size, list->index);
+#endif
+    return list;
+}
+
+int queue_save_all(int fd)
+{
+    /**
+     * Writes a checkpoint of every registered queue to `fd`.
+     *
+     * The stream starts with a small header holding the number of queues, followed by one
+     * `queue_save` checkpoint per queue in registration order. Only registered queues, those
+     * that have held an element, are saved; they may be empty now. Queues that were created
+     * but never pushed to are skipped, and `queue_load_all` gives the restored queues new
+     * indices, so indices are not preserved across a reload.
+     *
+     * @complexity Time complexity: O(N), where N is the total number of elements.
+     *
+     * @param fd File descriptor open for writing.
+     * @return The number of queues saved, or -1 on error.
+     */
+    uint32_t header[2] = {QUEUE_CHECKPOINT_ALL_MAGIC, 0};
+    for (int i = 0; i < next_index; i++)
+    {
+        header[1] += registered_queues[i] != NULL;
+    }
+    if (!queue_write_all(fd, header, sizeof(header)))
+    {
+        fprintf(stderr, "ERROR: Writing the checkpoint header failed: %s.\n", strerror(errno));
+        return -1;
+    }
+    for (int i = 0; i < next_index; i++)
+    {
+        if (registered_queues[i] != NULL && !queue_save(registered_queues[i], fd))
+        {
+            return -1;
+        }
+    }
+    return (int)header[1];
+}
+
+int queue_registry(struct LinkedList **out_lists, int max_lists)
+{
+    /**
+     * Copies the registered queues (those that have held an element) into `out_lists`.
+     *
+     * Registry slots are published with release stores and never cleared before the
+     * exit sweep, so another thread, such as the metrics sampler, may take a snapshot
+     * while the owners keep using their queues. Nothing is locked.
+     *
+     * @complexity Time complexity: O(MAX_QUEUES).
+     *
+     * @param out_lists Array that receives the queue pointers, in index order.
+     * @param max_lists Capacity of `out_lists`.
+     * @return The number of queues stored.
+     */
+    int count = 0;
+    for (int i = 0; out_lists && i < MAX_QUEUES && count < max_lists; i++)
+    {
+        struct LinkedList *list = __atomic_load_n(&registered_queues[i], __ATOMIC_ACQUIRE);
+        if (list != NULL)
+        {
+            out_lists[count++] = list;
+        }
+    }
+    return count;
+}
+
+int queue_load_all(int fd, struct LinkedList **out_lists, int max_lists)
+{
+    /**
+     * Reads a checkpoint written by `queue_save_all` and restores every queue in it.
+     *
+     * @note Restored queues are new queues with new indices, stored in `out_lists` in the
+     *       order they were saved.
+     *
+     * @complexity Time complexity: O(N), where N is the total number of elements.
+     *
+     * @param fd File descriptor open for reading.
+     * @param out_lists Array that receives the restored queues.
+     * @param max_lists Capacity of `out_lists`.
+     * @return The number of queues restored, or -1 on error or if `max_lists` is too small.
+     *         On error no queue is left behind: those already restored are freed.
+     */
+    uint32_t header[2];
+    if (!out_lists || !queue_read_all(fd, header, sizeof(header)) || header[0] != QUEUE_CHECKPOINT_ALL_MAGIC)
+    {
+        fprintf(stderr, "ERROR: Not a checkpoint of all QUEUES.\n");
+        return -1;
+    }
+    if (max_lists < 0 || header[1] > (uint32_t)max_lists)
+    {
+        fprintf(stderr, "ERROR: Checkpoint holds %u QUEUES, only room for %d.\n", header[1], max_lists);
+        return -1;
+    }
+    for (uint32_t i = 0; i < header[1]; i++)
+    {
+        out_lists[i] = queue_load(fd);
+        if (!out_lists[i])
+        {
+            while (i > 0)
+            {
+                queue_discard(out_lists[--i]);
+                out_lists[i] = NULL;
+            }
+            return -1;
+        }
+    }
+    return (int)header[1];
+}
+
+#endif
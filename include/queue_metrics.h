@@ -0,0 +1,74 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef QUEUE_METRICS_H
+#define QUEUE_METRICS_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+#include "queue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Default sampling interval of the background sampler
+#define QUEUE_METRICS_DEFAULT_INTERVAL_NS 1000000000ULL
+
+// Default number of samples kept per queue (10 minutes at the default interval)
+#define QUEUE_METRICS_DEFAULT_CAPACITY 600
+
+// Output formats of queue_metrics_dump
+enum QueueMetricsFormat
+{
+    QUEUE_METRICS_PROMETHEUS,
+    QUEUE_METRICS_JSON
+};
+
+// One sample of a queue: wall-clock time, depth, operation totals and rates per second
+struct QueueMetricsSample
+{
+    uint64_t timestamp_ms;
+    uint64_t depth;
+    uint64_t pushed;
+    uint64_t popped;
+    double push_rate;
+    double pop_rate;
+};
+
+QUEUE_API bool queue_metrics_start(uint64_t interval_ns, int capacity);
+QUEUE_API void queue_metrics_stop(void);
+QUEUE_API void queue_metrics_sample(void);
+QUEUE_API int queue_metrics_read(int index, struct QueueMetricsSample *out_samples, int max_samples);
+QUEUE_API int queue_metrics_dump(FILE *out, enum QueueMetricsFormat format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef QUEUE_TRACE_H
+#define QUEUE_TRACE_H
+
+#include <stdint.h>
+
+/*
+ * Static tracepoints (USDT probes) of provider `libqueue`.
+ *
+ * QUEUE_TRACE1..3(name, args...) mark a probe site. Each site assembles to a single `nop`
+ * plus an ELF `.note.stapsdt` entry describing where the probe's arguments live, so
+ * perf, bpftrace and SystemTap can attach to a running process without recompiling:
+ *
+ *   bpftrace -e 'usdt:./build/libqueue.so:libqueue:queue_push { @depth = hist(arg2); }'
+ *
+ * The probes come from <sys/sdt.h> when it is installed. Otherwise an equivalent note is
+ * emitted inline on x86-64 and AArch64 ELF targets, and everywhere else the macros
+ * expand to nothing. Arguments are passed as signed 64-bit values; they are evaluated
+ * only as far as the compiler needs to name their location, usually a register that
+ * already holds them. Build with -DQUEUE_TRACING=0 to remove the probes entirely.
+ */
+#ifndef QUEUE_TRACING
+#define QUEUE_TRACING 1
+#endif
+
+#if QUEUE_TRACING && defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define QUEUE_TRACE_SDT 1
+#endif
+#endif
+
+#if QUEUE_TRACING && !defined(QUEUE_TRACE_SDT) && defined(__GNUC__) && defined(__ELF__) && \
+    (defined(__x86_64__) || defined(__aarch64__))
+#define QUEUE_TRACE_NOTE 1
+#endif
+
+#if defined(QUEUE_TRACE_SDT)
+
+#define QUEUE_TRACE1(name, a) DTRACE_PROBE1(libqueue, name, (int64_t)(a))
+#define QUEUE_TRACE2(name, a, b) DTRACE_PROBE2(libqueue, name, (int64_t)(a), (int64_t)(b))
+#define QUEUE_TRACE3(name, a, b, c) DTRACE_PROBE3(libqueue, name, (int64_t)(a), (int64_t)(b), (int64_t)(c))
+
+#elif defined(QUEUE_TRACE_NOTE)
+
+// Same note layout as <sys/sdt.h> (type 3, "stapsdt"): probe pc, base address, semaphore, names, arguments
+#define QUEUE_TRACE_ASM(name, args)                                                  \
+    "990: nop\n"                                                                     \
+    ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                    \
+    ".balign 4\n"                                                                    \
+    ".4byte 992f-991f, 994f-993f, 3\n"                                               \
+    "991: .asciz \"stapsdt\"\n"                                                      \
+    "992: .balign 4\n"                                                               \
+    "993: .8byte 990b\n"                                                             \
+    ".8byte _.stapsdt.base\n"                                                        \
+    ".8byte 0\n"                                                                     \
+    ".asciz \"libqueue\"\n"                                                          \
+    ".asciz \"" #name "\"\n"                                                         \
+    ".asciz \"" args "\"\n"                                                          \
+    "994: .balign 4\n"                                                               \
+    ".popsection\n"                                                                  \
+    ".ifndef _.stapsdt.base\n"                                                       \
+    ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"          \
+    ".weak _.stapsdt.base\n"                                                         \
+    ".hidden _.stapsdt.base\n"                                                       \
+    "_.stapsdt.base: .space 1\n"                                                     \
+    ".size _.stapsdt.base, 1\n"                                                      \
+    ".popsection\n"                                                                  \
+    ".endif\n"
+
+#define QUEUE_TRACE1(name, a) \
+    __asm__ __volatile__(QUEUE_TRACE_ASM(name, "-8@%[a0]") : : [a0] "nor"((int64_t)(a)))
+#define QUEUE_TRACE2(name, a, b)                                 \
+    __asm__ __volatile__(QUEUE_TRACE_ASM(name, "-8@%[a0] -8@%[a1]") \
+                         :                                       \
+                         : [a0] "nor"((int64_t)(a)), [a1] "nor"((int64_t)(b)))
+#define QUEUE_TRACE3(name, a, b, c)                                          \
+    __asm__ __volatile__(QUEUE_TRACE_ASM(name, "-8@%[a0] -8@%[a1] -8@%[a2]")   \
+                         :                                                   \
+                         : [a0] "nor"((int64_t)(a)), [a1] "nor"((int64_t)(b)), \
+                           [a2] "nor"((int64_t)(c)))
+
+#else
+
+#define QUEUE_TRACE1(name, a) ((void)0)
+#define QUEUE_TRACE2(name, a, b) ((void)0)
+#define QUEUE_TRACE3(name, a, b, c) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SET_QUEUE_H
+#define SET_QUEUE_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Initial number of hash set slots; the set doubles when it becomes half full
+#define SET_QUEUE_INITIAL_SLOTS 64
+
+struct SetQueue;
+
+QUEUE_API struct SetQueue *set_queue_create(void);
+QUEUE_API struct SetQueue *set_queue_create_range(int min_value, int max_value);
+QUEUE_API bool set_queue_push(struct SetQueue *queue, int data);
+QUEUE_API bool set_queue_pop(struct SetQueue *queue, int *out_value);
+QUEUE_API bool set_queue_peek(struct SetQueue *queue, int *out_value);
+QUEUE_API bool set_queue_contains(struct SetQueue *queue, int data);
+QUEUE_API size_t set_queue_size(struct SetQueue *queue);
+QUEUE_API bool set_queue_is_empty(struct SetQueue *queue);
+QUEUE_API size_t set_queue_memory_usage(struct SetQueue *queue);
+QUEUE_API void set_queue_free(struct SetQueue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Default number of tasks that may be submitted and not yet finished at once
+#define THREAD_POOL_DEFAULT_CAPACITY 4096
+
+// Empty polls of the submission queue before an idle worker blocks
+#define THREAD_POOL_SPINS_BEFORE_PARK 64
+
+// Concurrent queue that carries submitted tasks to the workers
+enum ThreadPoolQueue
+{
+    THREAD_POOL_SEG_QUEUE,
+    THREAD_POOL_MS_QUEUE,
+    THREAD_POOL_FC_QUEUE
+};
+
+// Counters describing how tasks were dispatched
+struct ThreadPoolStats
+{
+    uint64_t submitted;
+    uint64_t executed;
+    uint64_t helped;
+    uint64_t parks;
+    uint64_t wakeups;
+    uint64_t full_stalls;
+};
+
+struct ThreadPool;
+
+QUEUE_API struct ThreadPool *thread_pool_create(int workers, enum ThreadPoolQueue queue, int capacity);
+QUEUE_API bool thread_pool_submit(struct ThreadPool *pool, void (*fn)(void *arg), void *arg);
+QUEUE_API void thread_pool_wait(struct ThreadPool *pool);
+QUEUE_API void thread_pool_parallel_for(struct ThreadPool *pool, long begin, long end, long grain,
+                                        void (*fn)(void *arg, long begin, long end), void *arg);
+QUEUE_API int thread_pool_size(struct ThreadPool *pool);
+QUEUE_API void thread_pool_get_stats(struct ThreadPool *pool, struct ThreadPoolStats *out);
+QUEUE_API void thread_pool_shutdown(struct ThreadPool *pool);
+QUEUE_API void thread_pool_free(struct ThreadPool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025 Pedro H C Rigon
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef URING_SINK_H
+#define URING_SINK_H
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include "queue_api.h"
+#include <stdint.h>
+#include "queue.h"
+#include "batch_controller.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Default size in bytes of each registered buffer and number of buffers written per batch
+#define URING_SINK_BUFFER_SIZE (64 * 1024)
+#define URING_SINK_DEPTH 8
+
+// Counters describing the work done by a sink
+struct UringSinkStats
+{
+    uint64_t elements;
+    uint64_t bytes;
+    uint64_t writes;
+    uint64_t batches;
+    uint64_t syscalls;
+    struct BatchControllerStats batching;
+};
+
+struct UringSink;
+
+QUEUE_API struct UringSink *uring_sink_create(int fd, size_t buffer_size, int depth);
+QUEUE_API void uring_sink_set_target_latency(struct UringSink *sink, uint64_t target_latency_ns);
+QUEUE_API long uring_sink_drain(struct UringSink *sink, struct LinkedList *list);
+QUEUE_API void uring_sink_get_stats(struct UringSink *sink, struct UringSinkStats *out);
+QUEUE_API void uring_sink_free(struct UringSink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,472 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <string.h>
+#include "affinity.h"
+
+// Root of the CPU topology in sysfs
+#define AFFINITY_SYSFS_ROOT "/sys/devices/system/cpu"
+
+// Highest cache index directory probed per CPU
+#define AFFINITY_MAX_CACHE_INDEX 8
+
+// CPUs chosen for the producer and the consumer of one queue
+struct AffinityEndpoints
+{
+    const void *queue;
+    enum AffinityPlacement placement;
+    int producer_cpu;
+    int consumer_cpu;
+};
+
+static struct CpuTopology affinity_detected;
+static pthread_once_t affinity_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t affinity_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct AffinityEndpoints affinity_endpoints[AFFINITY_MAX_QUEUES];
+
+static const char *affinity_placement_names[AFFINITY_PLACEMENTS] = {
+    [AFFINITY_SAME_CPU] = "same-cpu",
+    [AFFINITY_SMT_SIBLING] = "smt-sibling",
+    [AFFINITY_SAME_LLC] = "same-llc",
+    [AFFINITY_CROSS_LLC] = "cross-llc",
+    [AFFINITY_CROSS_SOCKET] = "cross-socket",
+};
+
+static bool affinity_read_line(const char *path, char *buffer, size_t size)
+{
+    /**
+     * Reads the first line of a sysfs file into `buffer`.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @return `true` if a line was read, `false` if the file is missing or empty.
+     */
+    FILE *file = fopen(path, "r");
+    if (!file)
+    {
+        return false;
+    }
+    bool ok = fgets(buffer, (int)size, file) != NULL;
+    fclose(file);
+    return ok;
+}
+
+static int affinity_read_int(const char *path, int fallback)
+{
+    /**
+     * Reads a sysfs file holding a single integer, such as `physical_package_id`.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @return The value, or `fallback` if the file cannot be read.
+     */
+    char line[64];
+    return affinity_read_line(path, line, sizeof(line)) ? atoi(line) : fallback;
+}
+
+static int affinity_first_cpu(const char *path, int fallback)
+{
+    /**
+     * Returns the lowest CPU of a sysfs CPU list such as "0-3,8-11", which names the
+     * group of CPUs that share a core or a cache.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    char line[256];
+    if (!affinity_read_line(path, line, sizeof(line)))
+    {
+        return fallback;
+    }
+    char *end;
+    long cpu = strtol(line, &end, 10);
+    return end == line ? fallback : (int)cpu;
+}
+
+static int affinity_count_distinct(const struct CpuTopology *topology, size_t offset)
+{
+    /**
+     * Counts the distinct values of one `CpuInfo` field over all CPUs.
+     *
+     * @complexity Time complexity: O(n^2), where n is the number of CPUs.
+     */
+    int count = 0;
+    for (int i = 0; i < topology->cpu_count; i++)
+    {
+        int value = *(const int *)((const char *)&topology->cpus[i] + offset);
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++)
+        {
+            seen = *(const int *)((const char *)&topology->cpus[j] + offset) == value;
+        }
+        count += !seen;
+    }
+    return count;
+}
+
+static void affinity_detect(const char *root, const cpu_set_t *allowed, struct CpuTopology *out)
+{
+    /**
+     * Builds the topology of the CPUs in `allowed` from the sysfs tree under `root`.
+     *
+     * SMT siblings come from `topology/thread_siblings_list`, the socket from
+     * `topology/physical_package_id` and the last-level cache from the highest-level
+     * data or unified cache under `cache/index*`. A CPU whose files are missing is
+     * treated as its own core and cache on socket 0.
+     *
+     * @complexity Time complexity: O(n^2), where n is the number of CPUs.
+     */
+    char path[256];
+    memset(out, 0, sizeof(*out));
+    for (int cpu = 0; cpu < AFFINITY_MAX_CPUS && cpu < CPU_SETSIZE; cpu++)
+    {
+        if (!CPU_ISSET(cpu, allowed))
+        {
+            continue;
+        }
+        struct CpuInfo *info = &out->cpus[out->cpu_count++];
+        info->cpu = cpu;
+        snprintf(path, sizeof(path), "%s/cpu%d/topology/thread_siblings_list", root, cpu);
+        info->core = affinity_first_cpu(path, cpu);
+        snprintf(path, sizeof(path), "%s/cpu%d/topology/physical_package_id", root, cpu);
+        info->socket = affinity_read_int(path, 0);
+        info->llc = cpu;
+
+        int best_level = 0;
+        for (int index = 0; index < AFFINITY_MAX_CACHE_INDEX; index++)
+        {
+            char type[32];
+            snprintf(path, sizeof(path), "%s/cpu%d/cache/index%d/type", root, cpu, index);
+            if (!affinity_read_line(path, type, sizeof(type)))
+            {
+                break;
+            }
+            if (strncmp(type, "Instruction", 11) == 0)
+            {
+                continue;
+            }
+            snprintf(path, sizeof(path), "%s/cpu%d/cache/index%d/level", root, cpu, index);
+            int level = affinity_read_int(path, 0);
+            if (level > best_level)
+            {
+                snprintf(path, sizeof(path), "%s/cpu%d/cache/index%d/shared_cpu_list", root, cpu, index);
+                best_level = level;
+                info->llc = affinity_first_cpu(path, cpu);
+            }
+        }
+        out->llc_level = best_level > out->llc_level ? best_level : out->llc_level;
+    }
+    out->core_count = affinity_count_distinct(out, offsetof(struct CpuInfo, core));
+    out->llc_count = affinity_count_distinct(out, offsetof(struct CpuInfo, llc));
+    out->socket_count = affinity_count_distinct(out, offsetof(struct CpuInfo, socket));
+}
+
+static void affinity_detect_once(void)
+{
+    /**
+     * `pthread_once` routine behind `affinity_topology`: detects the CPUs of the
+     * process's current affinity mask, or CPU 0 alone if the mask cannot be read.
+     *
+     * @complexity Time complexity: O(n^2), where n is the number of CPUs.
+     */
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    {
+        CPU_ZERO(&allowed);
+        CPU_SET(0, &allowed);
+    }
+    affinity_detect(AFFINITY_SYSFS_ROOT, &allowed, &affinity_detected);
+}
+
+const struct CpuTopology *affinity_topology(void)
+{
+    /**
+     * Returns the topology of the CPUs the process may run on.
+     *
+     * It is read from sysfs on the first call and cached. The CPUs are those of the
+     * process's affinity mask at that moment, so call this (or any other affinity
+     * function) before pinning the main thread.
+     *
+     * @complexity Time complexity: O(n^2) on the first call, where n is the number of
+     *             CPUs; O(1) afterwards.
+     *
+     * @return Pointer to the cached topology.
+     */
+    pthread_once(&affinity_once, affinity_detect_once);
+    return &affinity_detected;
+}
+
+void affinity_print_topology(FILE *out)
+{
+    /**
+     * Writes the detected topology: a summary line, then one line per CPU with the core,
+     * last-level cache and socket it belongs to.
+     *
+     * @complexity Time complexity: O(n), where n is the number of CPUs.
+     *
+     * @param out Stream to write to.
+     */
+    const struct CpuTopology *topology = affinity_topology();
+    if (!out)
+    {
+        return;
+    }
+    fprintf(out, "%d CPUs, %d cores, %d L%d caches, %d sockets\n", topology->cpu_count, topology->core_count,
+            topology->llc_count, topology->llc_level, topology->socket_count);
+    for (int i = 0; i < topology->cpu_count; i++)
+    {
+        const struct CpuInfo *info = &topology->cpus[i];
+        fprintf(out, "  cpu %3d: core %3d, llc %3d, socket %d\n", info->cpu, info->core, info->llc, info->socket);
+    }
+}
+
+const char *affinity_placement_name(enum AffinityPlacement placement)
+{
+    /**
+     * Returns a short name for a placement, e.g. "same-llc".
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param placement The placement.
+     * @return The name, or "unknown" for an invalid placement.
+     */
+    return placement >= 0 && placement < AFFINITY_PLACEMENTS ? affinity_placement_names[placement] : "unknown";
+}
+
+static bool affinity_matches(enum AffinityPlacement placement, const struct CpuInfo *a, const struct CpuInfo *b)
+{
+    /**
+     * Checks whether producer CPU `a` and consumer CPU `b` have the relation of
+     * `placement`. The relations are disjoint: e.g. `AFFINITY_SAME_LLC` requires
+     * different cores, so it never returns an SMT pair.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    switch (placement)
+    {
+    case AFFINITY_SAME_CPU:
+        return a->cpu == b->cpu;
+    case AFFINITY_SMT_SIBLING:
+        return a->cpu != b->cpu && a->core == b->core;
+    case AFFINITY_SAME_LLC:
+        return a->core != b->core && a->llc == b->llc;
+    case AFFINITY_CROSS_LLC:
+        return a->llc != b->llc && a->socket == b->socket;
+    case AFFINITY_CROSS_SOCKET:
+        return a->socket != b->socket;
+    default:
+        return false;
+    }
+}
+
+bool affinity_find_pair(enum AffinityPlacement placement, int *out_producer_cpu, int *out_consumer_cpu)
+{
+    /**
+     * Finds a producer CPU and a consumer CPU with the given relation:
+     * `AFFINITY_SAME_CPU` (one CPU), `AFFINITY_SMT_SIBLING` (two hardware threads of one
+     * core), `AFFINITY_SAME_LLC` (different cores sharing the last-level cache),
+     * `AFFINITY_CROSS_LLC` (different last-level caches on one socket) or
+     * `AFFINITY_CROSS_SOCKET`.
+     *
+     * The pair with the lowest CPU numbers is chosen, so the result is stable across
+     * runs on the same host.
+     *
+     * @complexity Time complexity: O(n^2), where n is the number of CPUs.
+     *
+     * @param placement The relation between the two CPUs.
+     * @param out_producer_cpu Receives the producer CPU.
+     * @param out_consumer_cpu Receives the consumer CPU.
+     * @return `true` if such a pair exists on this host, `false` otherwise.
+     */
+    const struct CpuTopology *topology = affinity_topology();
+    for (int i = 0; i < topology->cpu_count; i++)
+    {
+        for (int j = 0; j < topology->cpu_count; j++)
+        {
+            if (affinity_matches(placement, &topology->cpus[i], &topology->cpus[j]))
+            {
+                if (out_producer_cpu)
+                {
+                    *out_producer_cpu = topology->cpus[i].cpu;
+                }
+                if (out_consumer_cpu)
+                {
+                    *out_consumer_cpu = topology->cpus[j].cpu;
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool affinity_pin_thread(int cpu)
+{
+    /**
+     * Restricts the calling thread to one CPU with `sched_setaffinity`.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param cpu The CPU to run on.
+     * @return `true` if the thread was pinned, `false` if the CPU is invalid or not
+     *         allowed for this process.
+     */
+    affinity_topology();
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+    {
+        fprintf(stderr, "ERROR: Invalid CPU %d.\n", cpu);
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0)
+    {
+        fprintf(stderr, "ERROR: Failed to pin thread to CPU %d.\n", cpu);
+        return false;
+    }
+    return true;
+}
+
+static struct AffinityEndpoints *affinity_find(const void *queue)
+{
+    /**
+     * Returns the registry entry of `queue`, or the first free entry when `queue` is NULL.
+     *
+     * @note Called with `affinity_lock` held.
+     *
+     * @complexity Time complexity: O(q), where q is `AFFINITY_MAX_QUEUES`.
+     */
+    for (int i = 0; i < AFFINITY_MAX_QUEUES; i++)
+    {
+        if (affinity_endpoints[i].queue == queue)
+        {
+            return &affinity_endpoints[i];
+        }
+    }
+    return NULL;
+}
+
+bool affinity_set_policy(const void *queue, enum AffinityPlacement placement)
+{
+    /**
+     * Chooses the producer and consumer CPUs of a queue according to a placement.
+     *
+     * The queue may be any queue of the library (or any other object); only its address
+     * is used as a key. Its threads then pin themselves with
+     * `affinity_register_producer` and `affinity_register_consumer`.
+     *
+     * @complexity Time complexity: O(n^2 + q), where n is the number of CPUs and q is
+     *             `AFFINITY_MAX_QUEUES`.
+     *
+     * @param queue The queue the threads share.
+     * @param placement Where the consumer runs relative to the producer.
+     * @return `true` if the policy was set, `false` if this host has no such pair of
+     *         CPUs or `AFFINITY_MAX_QUEUES` queues already have one.
+     */
+    int producer_cpu;
+    int consumer_cpu;
+    if (!queue || !affinity_find_pair(placement, &producer_cpu, &consumer_cpu))
+    {
+        fprintf(stderr, "ERROR: No %s CPU pair available for QUEUE.\n", affinity_placement_name(placement));
+        return false;
+    }
+    pthread_mutex_lock(&affinity_lock);
+    struct AffinityEndpoints *endpoints = affinity_find(queue);
+    if (!endpoints)
+    {
+        endpoints = affinity_find(NULL);
+    }
+    if (endpoints)
+    {
+        *endpoints = (struct AffinityEndpoints){queue, placement, producer_cpu, consumer_cpu};
+    }
+    pthread_mutex_unlock(&affinity_lock);
+    if (!endpoints)
+    {
+        fprintf(stderr, "ERROR: Maximum number of QUEUES with a placement policy (%d) reached.\n", AFFINITY_MAX_QUEUES);
+        return false;
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: QUEUE placed %s: producer on CPU %d, consumer on CPU %d.\n",
+            affinity_placement_name(placement), producer_cpu, consumer_cpu);
+#endif
+    return true;
+}
+
+static int affinity_register(const void *queue, bool producer)
+{
+    /**
+     * Looks up the producer or consumer CPU of `queue` and pins the calling thread to it.
+     * The lock is released before pinning, so `sched_setaffinity` never runs under it.
+     *
+     * @complexity Time complexity: O(q), where q is `AFFINITY_MAX_QUEUES`.
+     *
+     * @return The CPU, or -1 if the queue has no policy or pinning fails.
+     */
+    pthread_mutex_lock(&affinity_lock);
+    struct AffinityEndpoints *endpoints = queue ? affinity_find(queue) : NULL;
+    int cpu = endpoints ? (producer ? endpoints->producer_cpu : endpoints->consumer_cpu) : -1;
+    pthread_mutex_unlock(&affinity_lock);
+    if (cpu < 0)
+    {
+        fprintf(stderr, "ERROR: QUEUE has no placement policy; call affinity_set_policy first.\n");
+        return -1;
+    }
+    return affinity_pin_thread(cpu) ? cpu : -1;
+}
+
+int affinity_register_producer(const void *queue)
+{
+    /**
+     * Registers the calling thread as a producer of the queue and pins it to the
+     * queue's producer CPU.
+     *
+     * @note Several producers of one queue share its producer CPU.
+     *
+     * @complexity Time complexity: O(q), where q is `AFFINITY_MAX_QUEUES`.
+     *
+     * @param queue A queue with a placement policy.
+     * @return The CPU the thread now runs on, or -1 on error.
+     */
+    return affinity_register(queue, true);
+}
+
+int affinity_register_consumer(const void *queue)
+{
+    /**
+     * Registers the calling thread as a consumer of the queue and pins it to the
+     * queue's consumer CPU.
+     *
+     * @note Several consumers of one queue share its consumer CPU.
+     *
+     * @complexity Time complexity: O(q), where q is `AFFINITY_MAX_QUEUES`.
+     *
+     * @param queue A queue with a placement policy.
+     * @return The CPU the thread now runs on, or -1 on error.
+     */
+    return affinity_register(queue, false);
+}
+
+void affinity_unregister(const void *queue)
+{
+    /**
+     * Forgets the placement policy of a queue, e.g. before the queue is freed.
+     * Threads that are already pinned stay pinned.
+     *
+     * @complexity Time complexity: O(q), where q is `AFFINITY_MAX_QUEUES`.
+     *
+     * @param queue The queue.
+     */
+    if (!queue)
+    {
+        return;
+    }
+    pthread_mutex_lock(&affinity_lock);
+    struct AffinityEndpoints *endpoints = affinity_find(queue);
+    if (endpoints)
+    {
+        *endpoints = (struct AffinityEndpoints){0};
+    }
+    pthread_mutex_unlock(&affinity_lock);
+}
@@ -0,0 +1,134 @@
+#include "batch_controller.h"
+
+void batch_controller_init(struct BatchController *controller, int min_batch, int max_batch, uint64_t target_latency_ns)
+{
+    /**
+     * Initializes a controller that tunes a batch size between `min_batch` and `max_batch`.
+     *
+     * With a target the batch starts at `min_batch` and grows as backlog is observed, so a
+     * lightly loaded stage never pays for a large first batch. With a `target_latency_ns`
+     * of 0 the controller is disabled and the batch stays at `max_batch`, which is the
+     * fixed-size behaviour.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param controller Pointer to the BatchController structure.
+     * @param min_batch Smallest batch size (at least 1).
+     * @param max_batch Largest batch size (at least `min_batch`).
+     * @param target_latency_ns Latency SLO for one batch; 0 disables adaptation.
+     */
+    if (!controller)
+    {
+        return;
+    }
+    if (min_batch < 1)
+    {
+        min_batch = 1;
+    }
+    if (max_batch < min_batch)
+    {
+        max_batch = min_batch;
+    }
+    controller->min_batch = min_batch;
+    controller->max_batch = max_batch;
+    controller->batch = target_latency_ns ? min_batch : max_batch;
+    controller->target_latency_ns = target_latency_ns;
+    controller->stats = (struct BatchControllerStats){0};
+    controller->stats.batch_size = (uint64_t)controller->batch;
+}
+
+int batch_controller_size(const struct BatchController *controller)
+{
+    /**
+     * Returns the batch size the next batch should use.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param controller Pointer to the BatchController structure.
+     * @return The current batch size.
+     */
+    return controller ? controller->batch : 1;
+}
+
+void batch_controller_update(struct BatchController *controller, size_t backlog, uint64_t latency_ns)
+{
+    /**
+     * Feeds the outcome of one batch back into the controller and adjusts the batch size.
+     *
+     * The policy is multiplicative increase with halving decrease around the latency SLO:
+     * - the batch is halved when the observed latency exceeds the target;
+     * - when the backlog could fill the current batch, the batch grows: it doubles while
+     *   the latency is under half the target and grows by a quarter closer to it;
+     * - when the backlog is under half a batch (the queue is nearly empty), the batch is
+     *   halved until it is at most twice the backlog; an idle queue drives it down to
+     *   `min_batch`, so elements are forwarded one by one instead of waiting for batches
+     *   to fill;
+     * - otherwise the batch is kept.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param controller Pointer to the BatchController structure.
+     * @param backlog Elements waiting behind this batch (queue depth or buffered count).
+     * @param latency_ns Latency of the batch, from its oldest element to its completion.
+     */
+    if (!controller || controller->target_latency_ns == 0)
+    {
+        return;
+    }
+    int batch = controller->batch;
+    controller->stats.updates++;
+
+    if (latency_ns > controller->target_latency_ns)
+    {
+        controller->stats.slo_violations++;
+        batch /= 2;
+    }
+    else if (backlog >= (size_t)batch)
+    {
+        batch = latency_ns * 2 < controller->target_latency_ns ? batch * 2 : batch + batch / 4 + 1;
+    }
+    else if (backlog < (size_t)batch / 2)
+    {
+        batch = (batch + 1) / 2;
+    }
+
+    if (batch < controller->min_batch)
+    {
+        batch = controller->min_batch;
+    }
+    if (batch > controller->max_batch)
+    {
+        batch = controller->max_batch;
+    }
+    if (batch > controller->batch)
+    {
+        controller->stats.grows++;
+    }
+    else if (batch < controller->batch)
+    {
+        controller->stats.shrinks++;
+    }
+    else
+    {
+        controller->stats.holds++;
+    }
+    controller->batch = batch;
+    controller->stats.batch_size = (uint64_t)batch;
+}
+
+void batch_controller_get_stats(const struct BatchController *controller, struct BatchControllerStats *out)
+{
+    /**
+     * Copies the controller's counters into `out`.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param controller Pointer to the BatchController structure.
+     * @param out Pointer to the structure that receives the counters.
+     */
+    if (!controller || !out)
+    {
+        return;
+    }
+    *out = controller->stats;
+}
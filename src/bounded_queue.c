@@ -0,0 +1,312 @@
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include "bounded_queue.h"
+#include "contention.h"
+
+#define BOUNDED_QUEUE_CACHE_LINE 64
+
+// A slot and its sequence number, which tells producers and consumers whose turn it is
+struct BoundedCell
+{
+    atomic_size_t sequence;
+    int value;
+};
+
+struct BoundedQueue
+{
+    alignas(BOUNDED_QUEUE_CACHE_LINE) atomic_size_t enqueue_pos;
+    alignas(BOUNDED_QUEUE_CACHE_LINE) atomic_size_t dequeue_pos;
+    alignas(BOUNDED_QUEUE_CACHE_LINE) size_t mask;
+    struct BoundedCell *cells;
+#if QUEUE_CONTENTION_PROFILE
+    struct ContentionProfile *contention;
+#endif
+};
+
+struct BoundedQueue *bounded_queue_create(int capacity)
+{
+    /**
+     * Allocates a bounded multi-producer/multi-consumer queue of `int` values.
+     *
+     * The queue is a ring of cells, each tagged with a sequence number (Vyukov's bounded
+     * MPMC queue). A producer claims the cell at the enqueue position with one CAS when
+     * the cell's sequence says it is free, writes the value and publishes it by bumping
+     * the sequence; consumers do the same on the dequeue side. No memory is allocated
+     * after creation, and a full queue rejects pushes instead of growing, which is what
+     * lets a consumer that falls behind slow its producers down.
+     *
+     * @note The created queue must be released with `bounded_queue_free`.
+     *
+     * @complexity Time complexity: O(c), where c is the capacity.
+     *
+     * @param capacity Number of values the queue holds, rounded up to a power of two
+     *                 (at least 2).
+     * @return Pointer to the newly created `BoundedQueue`, or NULL if creation fails.
+     */
+    if (capacity <= 0 || capacity > (1 << 30))
+    {
+        fprintf(stderr, "ERROR: Invalid bounded QUEUE capacity %d.\n", capacity);
+        return NULL;
+    }
+    size_t size = 2;
+    while (size < (size_t)capacity)
+    {
+        size <<= 1;
+    }
+    struct BoundedQueue *queue =
+        (struct BoundedQueue *)aligned_alloc(BOUNDED_QUEUE_CACHE_LINE, sizeof(struct BoundedQueue));
+    struct BoundedCell *cells = (struct BoundedCell *)malloc(size * sizeof(struct BoundedCell));
+    if (!queue || !cells)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for BoundedQueue.\n");
+        free(queue);
+        free(cells);
+        return NULL;
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        atomic_init(&cells[i].sequence, i);
+        cells[i].value = 0;
+    }
+    queue->cells = cells;
+    queue->mask = size - 1;
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+#if QUEUE_CONTENTION_PROFILE
+    queue->contention = contention_profile_create();
+#endif
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Bounded QUEUE initialized with %zu slots.\n", size);
+#endif
+    return queue;
+}
+
+bool bounded_queue_try_push(struct BoundedQueue *queue, int data)
+{
+    /**
+     * Adds the given data at the tail of the queue if there is room.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     *
+     * @complexity Time complexity: O(1) without contention.
+     *
+     * @param queue Pointer to the BoundedQueue structure.
+     * @param data The value to store.
+     * @return `true` if the value was stored, `false` if the queue is full.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return false;
+    }
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    for (;;)
+    {
+        struct BoundedCell *cell = &queue->cells[pos & queue->mask];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)pos;
+        if (difference == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueue_pos, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed))
+            {
+                cell->value = data;
+                atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+                return true;
+            }
+            QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+        }
+        else if (difference < 0)
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_FULL_STALL);
+            return false;
+        }
+        else
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+bool bounded_queue_try_pop(struct BoundedQueue *queue, int *out_value)
+{
+    /**
+     * Removes the front element of the queue if there is one.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     *
+     * @complexity Time complexity: O(1) without contention.
+     *
+     * @param queue Pointer to the BoundedQueue structure.
+     * @param out_value Pointer to an integer where the removed value will be stored.
+     * @return `true` if a value was removed, `false` if the queue is empty.
+     */
+    if (!queue || !out_value)
+    {
+        return false;
+    }
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    for (;;)
+    {
+        struct BoundedCell *cell = &queue->cells[pos & queue->mask];
+        size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)(pos + 1);
+        if (difference == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeue_pos, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed))
+            {
+                *out_value = cell->value;
+                atomic_store_explicit(&cell->sequence, pos + queue->mask + 1, memory_order_release);
+                return true;
+            }
+            QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+        }
+        else if (difference < 0)
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_EMPTY_STALL);
+            return false;
+        }
+        else
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+int bounded_queue_push_bulk(struct BoundedQueue *queue, const int *values, int count)
+{
+    /**
+     * Adds values from an array at the tail of the queue until it is full.
+     *
+     * @note Safe to call concurrently from any number of threads; values from concurrent
+     *       producers may interleave.
+     *
+     * @complexity Time complexity: O(k), where k is the number of values stored.
+     *
+     * @param queue Pointer to the BoundedQueue structure.
+     * @param values Array of values to store, in order.
+     * @param count Number of values in the array.
+     * @return The number of values stored, from the front of `values`.
+     */
+    int pushed = 0;
+    while (pushed < count && bounded_queue_try_push(queue, values[pushed]))
+    {
+        pushed++;
+    }
+    return pushed;
+}
+
+int bounded_queue_pop_bulk(struct BoundedQueue *queue, int *out_values, int max_count)
+{
+    /**
+     * Removes up to `max_count` elements from the front of the queue into an array.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     *
+     * @complexity Time complexity: O(k), where k is the number of values removed.
+     *
+     * @param queue Pointer to the BoundedQueue structure.
+     * @param out_values Array that receives the removed values, in order.
+     * @param max_count Maximum number of values to remove.
+     * @return The number of values removed.
+     */
+    int popped = 0;
+    while (popped < max_count && bounded_queue_try_pop(queue, &out_values[popped]))
+    {
+        popped++;
+    }
+    return popped;
+}
+
+int bounded_queue_size(struct BoundedQueue *queue)
+{
+    /**
+     * Returns the number of elements in the queue.
+     *
+     * @note Under concurrent use this is a snapshot that may be stale by the time it is
+     *       read, as with any concurrent queue depth.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the BoundedQueue structure.
+     * @return The number of elements, or 0 if the queue pointer is NULL.
+     */
+    if (!queue)
+    {
+        return 0;
+    }
+    size_t dequeue_pos = atomic_load_explicit(&queue->dequeue_pos, memory_order_relaxed);
+    size_t enqueue_pos = atomic_load_explicit(&queue->enqueue_pos, memory_order_relaxed);
+    intptr_t size = (intptr_t)(enqueue_pos - dequeue_pos);
+    if (size < 0)
+    {
+        return 0;
+    }
+    return size > (intptr_t)(queue->mask + 1) ? (int)(queue->mask + 1) : (int)size;
+}
+
+int bounded_queue_capacity(struct BoundedQueue *queue)
+{
+    /**
+     * Returns the number of elements the queue can hold.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the BoundedQueue structure.
+     * @return The capacity, or 0 if the queue pointer is NULL.
+     */
+    return queue ? (int)(queue->mask + 1) : 0;
+}
+
+bool bounded_queue_get_contention(struct BoundedQueue *queue, int thread_slot, struct ContentionStats *out)
+{
+    /**
+     * Reads the contention counters of the queue for one thread slot, or in total.
+     *
+     * Failed pushes on a full queue are counted as `full_stalls`, failed pops as
+     * `empty_stalls`.
+     *
+     * @note Counters are only kept when the library is built with
+     *       `-DQUEUE_CONTENTION_PROFILE=1` (`make contention`).
+     *
+     * @complexity Time complexity: O(1) for one slot, O(t) for the total over t slots.
+     *
+     * @param queue Pointer to the BoundedQueue structure.
+     * @param thread_slot A thread slot from `queue_thread_slot`, or -1 for the total.
+     * @param out Pointer to the structure that receives the counters.
+     * @return `true` if counters were read, `false` if profiling is compiled out.
+     */
+#if QUEUE_CONTENTION_PROFILE
+    return contention_profile_get(queue ? queue->contention : NULL, thread_slot, out);
+#else
+    (void)queue;
+    return contention_profile_get(NULL, thread_slot, out);
+#endif
+}
+
+void bounded_queue_free(struct BoundedQueue *queue)
+{
+    /**
+     * Frees the bounded queue and any values still stored in it.
+     *
+     * @note Must not be called while other threads still use the queue.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the BoundedQueue structure.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "INFO: QUEUE is already NULL. Skipping free.\n");
+        return;
+    }
+#if QUEUE_CONTENTION_PROFILE
+    contention_profile_free(queue->contention);
+#endif
+    free(queue->cells);
+    free(queue);
+}
@@ -0,0 +1,430 @@
+#include <string.h>
+#include "chunk_queue.h"
+#include "queue_trace.h"
+
+// Values are packed in 4 interleaved lanes: value i belongs to lane i % 4
+#define CHUNK_CODEC_LANES 4
+#define CHUNK_CODEC_ROWS (CHUNK_QUEUE_CHUNK_SIZE / CHUNK_CODEC_LANES)
+
+// Header words of an encoded chunk: bit width, frame of reference and first value
+#define CHUNK_CODEC_HEADER_WORDS 3
+
+struct ChunkBlock
+{
+    struct ChunkBlock *next;
+    size_t words;
+    uint32_t data[];
+};
+
+struct ChunkQueue
+{
+    enum ChunkQueueMode mode;
+    int head_values[CHUNK_QUEUE_CHUNK_SIZE];
+    int head_index;
+    int head_count;
+    struct ChunkBlock *cold_head;
+    struct ChunkBlock *cold_tail;
+    int tail_values[CHUNK_QUEUE_CHUNK_SIZE];
+    int tail_count;
+    size_t size;
+    size_t cold_bytes;
+};
+
+size_t chunk_codec_encode(const int *values, uint32_t *out_words)
+{
+    /**
+     * Compresses `CHUNK_QUEUE_CHUNK_SIZE` values with delta coding, a frame of reference
+     * and bit-packing.
+     *
+     * Each value is replaced by its difference to the value four positions earlier, so the
+     * deltas of the 4 lanes are independent. The smallest delta is subtracted from all of
+     * them (frame of reference, which also handles IDs that occasionally go backwards), and
+     * the results are packed with the bit width of the largest one. Lanes are interleaved
+     * word by word, the SIMD-BP128 layout: row j of every lane sits at the same bit offset,
+     * so the decoder processes 4 lanes with identical shifts, a loop the compiler turns into
+     * SIMD code.
+     *
+     * @complexity Time complexity: O(c), where c is `CHUNK_QUEUE_CHUNK_SIZE`.
+     *
+     * @param values Array of `CHUNK_QUEUE_CHUNK_SIZE` values.
+     * @param out_words Array with room for `CHUNK_CODEC_MAX_WORDS` words.
+     * @return The number of words written, `3 + 32 * bit width`.
+     */
+    uint32_t deltas[CHUNK_QUEUE_CHUNK_SIZE];
+    uint32_t previous[CHUNK_CODEC_LANES];
+    for (int lane = 0; lane < CHUNK_CODEC_LANES; lane++)
+    {
+        previous[lane] = (uint32_t)values[0];
+    }
+
+    int32_t reference = INT32_MAX;
+    for (int i = 0; i < CHUNK_QUEUE_CHUNK_SIZE; i++)
+    {
+        uint32_t value = (uint32_t)values[i];
+        deltas[i] = value - previous[i % CHUNK_CODEC_LANES];
+        previous[i % CHUNK_CODEC_LANES] = value;
+        if ((int32_t)deltas[i] < reference)
+        {
+            reference = (int32_t)deltas[i];
+        }
+    }
+
+    uint32_t max_offset = 0;
+    for (int i = 0; i < CHUNK_QUEUE_CHUNK_SIZE; i++)
+    {
+        deltas[i] -= (uint32_t)reference;
+        max_offset |= deltas[i];
+    }
+    uint32_t width = max_offset == 0 ? 0 : 32 - (uint32_t)__builtin_clz(max_offset);
+
+    out_words[0] = width;
+    out_words[1] = (uint32_t)reference;
+    out_words[2] = (uint32_t)values[0];
+    uint32_t *packed = out_words + CHUNK_CODEC_HEADER_WORDS;
+    size_t packed_words = (size_t)width * CHUNK_CODEC_ROWS / 32 * CHUNK_CODEC_LANES;
+    memset(packed, 0, packed_words * sizeof(uint32_t));
+    for (int row = 0; row < CHUNK_CODEC_ROWS && width > 0; row++)
+    {
+        uint32_t bit = (uint32_t)row * width;
+        uint32_t word = bit / 32;
+        uint32_t shift = bit % 32;
+        for (int lane = 0; lane < CHUNK_CODEC_LANES; lane++)
+        {
+            uint32_t delta = deltas[row * CHUNK_CODEC_LANES + lane];
+            packed[word * CHUNK_CODEC_LANES + lane] |= delta << shift;
+            if (shift + width > 32)
+            {
+                packed[(word + 1) * CHUNK_CODEC_LANES + lane] |= delta >> (32 - shift);
+            }
+        }
+    }
+    return CHUNK_CODEC_HEADER_WORDS + packed_words;
+}
+
+void chunk_codec_decode(const uint32_t *words, int *out_values)
+{
+    /**
+     * Restores the `CHUNK_QUEUE_CHUNK_SIZE` values compressed by `chunk_codec_encode`.
+     *
+     * @complexity Time complexity: O(c), where c is `CHUNK_QUEUE_CHUNK_SIZE`.
+     *
+     * @param words Encoded chunk.
+     * @param out_values Array with room for `CHUNK_QUEUE_CHUNK_SIZE` values.
+     */
+    uint32_t width = words[0];
+    uint32_t reference = words[1];
+    uint32_t mask = width == 32 ? UINT32_MAX : (1u << width) - 1;
+    const uint32_t *packed = words + CHUNK_CODEC_HEADER_WORDS;
+    uint32_t previous[CHUNK_CODEC_LANES];
+    for (int lane = 0; lane < CHUNK_CODEC_LANES; lane++)
+    {
+        previous[lane] = words[2];
+    }
+
+    for (int row = 0; row < CHUNK_CODEC_ROWS; row++)
+    {
+        uint32_t bit = (uint32_t)row * width;
+        uint32_t word = bit / 32;
+        uint32_t shift = bit % 32;
+        uint32_t deltas[CHUNK_CODEC_LANES];
+        if (width == 0)
+        {
+            for (int lane = 0; lane < CHUNK_CODEC_LANES; lane++)
+            {
+                deltas[lane] = 0;
+            }
+        }
+        else if (shift + width > 32)
+        {
+            for (int lane = 0; lane < CHUNK_CODEC_LANES; lane++)
+            {
+                deltas[lane] = ((packed[word * CHUNK_CODEC_LANES + lane] >> shift) |
+                                (packed[(word + 1) * CHUNK_CODEC_LANES + lane] << (32 - shift))) &
+                               mask;
+            }
+        }
+        else
+        {
+            for (int lane = 0; lane < CHUNK_CODEC_LANES; lane++)
+            {
+                deltas[lane] = (packed[word * CHUNK_CODEC_LANES + lane] >> shift) & mask;
+            }
+        }
+        for (int lane = 0; lane < CHUNK_CODEC_LANES; lane++)
+        {
+            previous[lane] += deltas[lane] + reference;
+            out_values[row * CHUNK_CODEC_LANES + lane] = (int)previous[lane];
+        }
+    }
+}
+
+struct ChunkQueue *chunk_queue_create(enum ChunkQueueMode mode)
+{
+    /**
+     * Allocates and initializes a new chunked queue.
+     *
+     * Elements are stored by value in chunks of `CHUNK_QUEUE_CHUNK_SIZE` instead of one
+     * node each. Pushes fill the tail chunk and pops drain the head chunk; full chunks in
+     * between are kept as blocks. With `CHUNK_QUEUE_COMPRESSED` those blocks are encoded
+     * with `chunk_codec_encode` when the tail chunk fills up and decoded lazily when the
+     * consumer reaches them, so a deep backlog of nearly sorted IDs costs about one or two
+     * bytes per element instead of 24 for a `struct Node`.
+     *
+     * @note The created queue must be released with `chunk_queue_free` to avoid memory leaks.
+     * @note The queue is not thread-safe.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param mode `CHUNK_QUEUE_PLAIN` or `CHUNK_QUEUE_COMPRESSED`.
+     * @return Pointer to the newly created `ChunkQueue` structure, or NULL if creation fails.
+     */
+    struct ChunkQueue *queue = (struct ChunkQueue *)malloc(sizeof(struct ChunkQueue));
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for ChunkQueue.\n");
+        return NULL;
+    }
+    queue->mode = mode;
+    queue->head_index = 0;
+    queue->head_count = 0;
+    queue->cold_head = NULL;
+    queue->cold_tail = NULL;
+    queue->tail_count = 0;
+    queue->size = 0;
+    queue->cold_bytes = 0;
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Chunked QUEUE initialized (%s).\n", mode == CHUNK_QUEUE_COMPRESSED ? "compressed" : "plain");
+#endif
+    return queue;
+}
+
+static void chunk_queue_seal_tail(struct ChunkQueue *queue)
+{
+    /**
+     * Moves the full tail chunk to the end of the block list, compressing it if enabled.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(c), where c is `CHUNK_QUEUE_CHUNK_SIZE`.
+     */
+    uint32_t encoded[CHUNK_CODEC_MAX_WORDS];
+    const uint32_t *source = (const uint32_t *)queue->tail_values;
+    size_t words = CHUNK_QUEUE_CHUNK_SIZE;
+    if (queue->mode == CHUNK_QUEUE_COMPRESSED)
+    {
+        words = chunk_codec_encode(queue->tail_values, encoded);
+        source = encoded;
+    }
+
+    size_t bytes = sizeof(struct ChunkBlock) + words * sizeof(uint32_t);
+    struct ChunkBlock *block = (struct ChunkBlock *)malloc(bytes);
+    if (block == NULL)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed in chunk_queue_push(). Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+    block->next = NULL;
+    block->words = words;
+    memcpy(block->data, source, words * sizeof(uint32_t));
+
+    if (queue->cold_tail)
+    {
+        queue->cold_tail->next = block;
+    }
+    else
+    {
+        queue->cold_head = block;
+    }
+    queue->cold_tail = block;
+    queue->cold_bytes += bytes;
+    queue->tail_count = 0;
+    QUEUE_TRACE3(chunk_queue_grow, (intptr_t)queue, bytes, queue->cold_bytes);
+}
+
+static bool chunk_queue_refill_head(struct ChunkQueue *queue)
+{
+    /**
+     * Loads the next chunk into the head buffer once the current one is consumed.
+     *
+     * The oldest block is decoded (or copied) and freed; without blocks, the elements of
+     * the partially filled tail chunk are moved to the head.
+     *
+     * @complexity Time complexity: O(c), where c is `CHUNK_QUEUE_CHUNK_SIZE`.
+     *
+     * @return `true` if the head buffer holds an element, `false` if the queue is empty.
+     */
+    if (queue->head_index < queue->head_count)
+    {
+        return true;
+    }
+
+    struct ChunkBlock *block = queue->cold_head;
+    if (block)
+    {
+        if (queue->mode == CHUNK_QUEUE_COMPRESSED)
+        {
+            chunk_codec_decode(block->data, queue->head_values);
+        }
+        else
+        {
+            memcpy(queue->head_values, block->data, sizeof(queue->head_values));
+        }
+        queue->cold_head = block->next;
+        if (!queue->cold_head)
+        {
+            queue->cold_tail = NULL;
+        }
+        queue->cold_bytes -= sizeof(struct ChunkBlock) + block->words * sizeof(uint32_t);
+        free(block);
+        queue->head_count = CHUNK_QUEUE_CHUNK_SIZE;
+    }
+    else if (queue->tail_count > 0)
+    {
+        memcpy(queue->head_values, queue->tail_values, (size_t)queue->tail_count * sizeof(int));
+        queue->head_count = queue->tail_count;
+        queue->tail_count = 0;
+    }
+    else
+    {
+        return false;
+    }
+    queue->head_index = 0;
+    return true;
+}
+
+void chunk_queue_push(struct ChunkQueue *queue, int data)
+{
+    /**
+     * Adds the given data at the tail of the chunked queue.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1) amortized; every `CHUNK_QUEUE_CHUNK_SIZE` pushes
+     *             one chunk is sealed (and encoded in compressed mode).
+     *
+     * @param queue Pointer to the ChunkQueue structure.
+     * @param data The value to store.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return;
+    }
+    queue->tail_values[queue->tail_count++] = data;
+    queue->size++;
+    if (queue->tail_count == CHUNK_QUEUE_CHUNK_SIZE)
+    {
+        chunk_queue_seal_tail(queue);
+    }
+}
+
+bool chunk_queue_pop(struct ChunkQueue *queue, int *out_value)
+{
+    /**
+     * Removes the front element of the chunked queue and stores it in `out_value`.
+     *
+     * @complexity Time complexity: O(1) amortized; every `CHUNK_QUEUE_CHUNK_SIZE` pops
+     *             one chunk is loaded (and decoded in compressed mode).
+     *
+     * @param queue Pointer to the ChunkQueue structure.
+     * @param out_value Pointer to an integer where the removed value will be stored.
+     * @return `true` if an element was removed, `false` if the queue is empty or NULL.
+     */
+    if (!queue || !chunk_queue_refill_head(queue))
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop from an empty or NULL QUEUE.\n");
+#endif
+        return false;
+    }
+    *out_value = queue->head_values[queue->head_index++];
+    queue->size--;
+    return true;
+}
+
+bool chunk_queue_peek(struct ChunkQueue *queue, int *out_value)
+{
+    /**
+     * Retrieves the front element of the chunked queue without removing it.
+     *
+     * @complexity Time complexity: O(1) amortized.
+     *
+     * @param queue Pointer to the ChunkQueue structure.
+     * @param out_value Pointer to an integer where the front value will be stored.
+     * @return `true` if the queue has an element, `false` if it is empty or NULL.
+     */
+    if (!queue || !chunk_queue_refill_head(queue))
+    {
+        return false;
+    }
+    *out_value = queue->head_values[queue->head_index];
+    return true;
+}
+
+size_t chunk_queue_size(struct ChunkQueue *queue)
+{
+    /**
+     * Returns the number of elements in the chunked queue.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the ChunkQueue structure.
+     * @return The number of elements, or 0 if the queue pointer is NULL.
+     */
+    return queue ? queue->size : 0;
+}
+
+bool chunk_queue_is_empty(struct ChunkQueue *queue)
+{
+    /**
+     * Checks if the chunked queue is empty.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the ChunkQueue structure.
+     * @return `true` if the queue is empty or the queue pointer is NULL, `false` otherwise.
+     */
+    return (queue == NULL || queue->size == 0);
+}
+
+size_t chunk_queue_memory_usage(struct ChunkQueue *queue)
+{
+    /**
+     * Returns the number of bytes the chunked queue allocated: the structure with its head
+     * and tail buffers plus every stored block.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the ChunkQueue structure.
+     * @return The allocated size in bytes, or 0 if the queue pointer is NULL.
+     */
+    return queue ? sizeof(struct ChunkQueue) + queue->cold_bytes : 0;
+}
+
+void chunk_queue_free(struct ChunkQueue *queue)
+{
+    /**
+     * Frees the chunked queue and every block still stored in it.
+     *
+     * @complexity Time complexity: O(n / c), where n is the number of elements and c is
+     *             `CHUNK_QUEUE_CHUNK_SIZE`.
+     *
+     * @param queue Pointer to the ChunkQueue structure.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "INFO: QUEUE is already NULL. Skipping free.\n");
+        return;
+    }
+    struct ChunkBlock *iterator = queue->cold_head;
+    while (iterator != NULL)
+    {
+        struct ChunkBlock *temp = iterator;
+        iterator = iterator->next;
+        free(temp);
+    }
+    free(queue);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Chunked QUEUE has been freed.\n");
+#endif
+}
@@ -0,0 +1,135 @@
+#include <stdatomic.h>
+#include <stdalign.h>
+#include "contention.h"
+#include "thread_slot.h"
+
+#define CONTENTION_CACHE_LINE 64
+
+// Counters of one thread slot, on their own cache line so recording never bounces lines
+struct ContentionCounters
+{
+    alignas(CONTENTION_CACHE_LINE) _Atomic uint64_t events[CONTENTION_EVENTS];
+};
+
+// One record per thread slot, plus a shared record for threads that have no slot
+struct ContentionProfile
+{
+    struct ContentionCounters threads[QUEUE_MAX_THREADS + 1];
+};
+
+struct ContentionProfile *contention_profile_create(void)
+{
+    /**
+     * Allocates a zeroed contention profile with one counter record per thread slot.
+     *
+     * Concurrent queues create a profile for themselves when the library is built with
+     * `-DQUEUE_CONTENTION_PROFILE=1` and report it through their `_get_contention` call.
+     *
+     * @note The created profile must be released with `contention_profile_free`.
+     *
+     * @complexity Time complexity: O(QUEUE_MAX_THREADS).
+     *
+     * @return Pointer to the new profile, or NULL if allocation fails.
+     */
+    struct ContentionProfile *profile =
+        (struct ContentionProfile *)aligned_alloc(CONTENTION_CACHE_LINE, sizeof(struct ContentionProfile));
+    if (!profile)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for ContentionProfile.\n");
+        return NULL;
+    }
+    for (int t = 0; t <= QUEUE_MAX_THREADS; t++)
+    {
+        for (int e = 0; e < CONTENTION_EVENTS; e++)
+        {
+            atomic_init(&profile->threads[t].events[e], 0);
+        }
+    }
+    return profile;
+}
+
+void contention_profile_record(struct ContentionProfile *profile, enum ContentionEvent event)
+{
+    /**
+     * Counts one contention event for the calling thread.
+     *
+     * Each thread slot owns its record, so the count is a relaxed load and store on a
+     * cache line no other thread writes; only threads without a slot share a record and
+     * pay for an atomic add.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param profile Pointer to the ContentionProfile structure (NULL is ignored).
+     * @param event The event to count.
+     */
+    if (!profile)
+    {
+        return;
+    }
+    int slot = queue_thread_slot();
+    if (slot < 0)
+    {
+        atomic_fetch_add_explicit(&profile->threads[QUEUE_MAX_THREADS].events[event], 1, memory_order_relaxed);
+        return;
+    }
+    _Atomic uint64_t *counter = &profile->threads[slot].events[event];
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+bool contention_profile_get(const struct ContentionProfile *profile, int thread_slot, struct ContentionStats *out)
+{
+    /**
+     * Reads the counters of one thread slot, or their sum over all threads.
+     *
+     * Slots are the ones returned by `queue_thread_slot`; iterate up to
+     * `queue_thread_slot_limit()` for a per-thread breakdown. A slot is reused after its
+     * thread exits, so its counters accumulate over the threads that held it.
+     *
+     * @complexity Time complexity: O(1) for one slot, O(t) for the sum over t slots.
+     *
+     * @param profile Pointer to the ContentionProfile structure.
+     * @param thread_slot A thread slot, or -1 for the total over all threads.
+     * @param out Pointer to the structure that receives the counters.
+     * @return `true` if counters were read, `false` if there is no profile (profiling is
+     *         compiled out) or the slot is out of range; `out` is then zeroed.
+     */
+    if (!out)
+    {
+        return false;
+    }
+    *out = (struct ContentionStats){0};
+    if (!profile || thread_slot < -1 || thread_slot >= QUEUE_MAX_THREADS)
+    {
+        return false;
+    }
+    uint64_t events[CONTENTION_EVENTS] = {0};
+    int first = thread_slot < 0 ? 0 : thread_slot;
+    int last = thread_slot < 0 ? QUEUE_MAX_THREADS : thread_slot;
+    for (int t = first; t <= last; t++)
+    {
+        for (int e = 0; e < CONTENTION_EVENTS; e++)
+        {
+            events[e] += atomic_load_explicit(&profile->threads[t].events[e], memory_order_relaxed);
+        }
+    }
+    out->cas_failures = events[CONTENTION_CAS_FAILURE];
+    out->spins = events[CONTENTION_SPIN];
+    out->yields = events[CONTENTION_YIELD];
+    out->parks = events[CONTENTION_PARK];
+    out->unparks = events[CONTENTION_UNPARK];
+    out->full_stalls = events[CONTENTION_FULL_STALL];
+    out->empty_stalls = events[CONTENTION_EMPTY_STALL];
+    return true;
+}
+
+void contention_profile_free(struct ContentionProfile *profile)
+{
+    /**
+     * Frees a contention profile.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param profile Pointer to the ContentionProfile structure (NULL is ignored).
+     */
+    free(profile);
+}
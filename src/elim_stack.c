@@ -0,0 +1,329 @@
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include "elim_stack.h"
+#include "epoch.h"
+#include "contention.h"
+
+#define ELIM_STACK_CACHE_LINE 64
+
+// Exchange slot states: free, holding a waiting push, and claimed by a pop
+#define ELIM_SLOT_EMPTY 0ULL
+#define ELIM_SLOT_WAITING (1ULL << 32)
+#define ELIM_SLOT_BUSY (2ULL << 32)
+#define ELIM_SLOT_STATE_MASK (3ULL << 32)
+
+struct ElimNode
+{
+    int data;
+    struct ElimNode *next;
+};
+
+struct ElimSlot
+{
+    alignas(ELIM_STACK_CACHE_LINE) _Atomic uint64_t state;
+};
+
+struct ElimStack
+{
+    alignas(ELIM_STACK_CACHE_LINE) _Atomic(struct ElimNode *) top;
+    alignas(ELIM_STACK_CACHE_LINE) int width;
+#if QUEUE_CONTENTION_PROFILE
+    struct ContentionProfile *contention;
+#endif
+    struct ElimSlot slots[];
+};
+
+static _Thread_local uint32_t elim_random_state = 0;
+
+static uint32_t elim_random(void)
+{
+    /**
+     * Returns a thread-local pseudo-random number used to pick exchange slots.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    uint32_t x = elim_random_state;
+    if (x == 0)
+    {
+        x = (uint32_t)(uintptr_t)&elim_random_state | 1u;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    elim_random_state = x;
+    return x;
+}
+
+struct ElimStack *elim_stack_create(int width)
+{
+    /**
+     * Allocates and initializes a new lock-free stack with an elimination array.
+     *
+     * The stack is a Treiber stack: push and pop operate on the same end through a CAS on
+     * `top`. When that CAS fails under contention, the thread backs off into an
+     * elimination array of `width` exchange slots, where a push and a pop that meet cancel
+     * each other out without touching `top`.
+     *
+     * @note The created stack must be released with `elim_stack_free` to avoid memory leaks.
+     *
+     * @complexity Time complexity: O(w), where w is `width`.
+     *
+     * @param width Number of exchange slots; 0 disables elimination.
+     * @return Pointer to the newly created `ElimStack` structure, or NULL if creation fails.
+     */
+    if (width < 0)
+    {
+        width = 0;
+    }
+    size_t size = sizeof(struct ElimStack) + (size_t)width * sizeof(struct ElimSlot);
+    size = (size + ELIM_STACK_CACHE_LINE - 1) / ELIM_STACK_CACHE_LINE * ELIM_STACK_CACHE_LINE;
+    struct ElimStack *stack = (struct ElimStack *)aligned_alloc(ELIM_STACK_CACHE_LINE, size);
+    if (!stack)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for ElimStack.\n");
+        return NULL;
+    }
+    atomic_init(&stack->top, NULL);
+    stack->width = width;
+#if QUEUE_CONTENTION_PROFILE
+    stack->contention = contention_profile_create();
+#endif
+    for (int i = 0; i < width; i++)
+    {
+        atomic_init(&stack->slots[i].state, ELIM_SLOT_EMPTY);
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Lock-free STACK initialized with %d elimination slots.\n", width);
+#endif
+    return stack;
+}
+
+static bool elim_stack_try_push_exchange(struct ElimStack *stack, int data)
+{
+    /**
+     * Offers a value in a random exchange slot and waits for a pop to take it.
+     *
+     * The push parks its value in an empty slot for up to `ELIM_STACK_WAIT_SPINS`
+     * iterations. If a pop claims it in the meantime the push completes without ever
+     * touching `top`; otherwise the offer is withdrawn.
+     *
+     * @complexity Time complexity: O(ELIM_STACK_WAIT_SPINS).
+     *
+     * @return `true` if the value was handed to a pop, `false` otherwise.
+     */
+    struct ElimSlot *slot = &stack->slots[elim_random() % (uint32_t)stack->width];
+    uint64_t offer = ELIM_SLOT_WAITING | (uint32_t)data;
+    uint64_t expected = ELIM_SLOT_EMPTY;
+    if (!atomic_compare_exchange_strong(&slot->state, &expected, offer))
+    {
+        return false;
+    }
+    for (int spin = 0; spin < ELIM_STACK_WAIT_SPINS; spin++)
+    {
+        if (atomic_load_explicit(&slot->state, memory_order_acquire) == ELIM_SLOT_BUSY)
+        {
+            atomic_store_explicit(&slot->state, ELIM_SLOT_EMPTY, memory_order_release);
+            return true;
+        }
+        QUEUE_CONTENTION(stack->contention, CONTENTION_SPIN);
+    }
+    expected = offer;
+    if (atomic_compare_exchange_strong(&slot->state, &expected, ELIM_SLOT_EMPTY))
+    {
+        return false;
+    }
+    atomic_store_explicit(&slot->state, ELIM_SLOT_EMPTY, memory_order_release);
+    return true;
+}
+
+static bool elim_stack_try_pop_exchange(struct ElimStack *stack, int *out_value)
+{
+    /**
+     * Takes a value offered by a waiting push in a random exchange slot, if any.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @return `true` if a value was taken, `false` otherwise.
+     */
+    struct ElimSlot *slot = &stack->slots[elim_random() % (uint32_t)stack->width];
+    uint64_t state = atomic_load(&slot->state);
+    if ((state & ELIM_SLOT_STATE_MASK) != ELIM_SLOT_WAITING)
+    {
+        return false;
+    }
+    if (!atomic_compare_exchange_strong(&slot->state, &state, ELIM_SLOT_BUSY))
+    {
+        return false;
+    }
+    *out_value = (int)(uint32_t)state;
+    return true;
+}
+
+void elim_stack_push(struct ElimStack *stack, int data)
+{
+    /**
+     * Pushes the given data on top of the stack.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1) without contention.
+     *
+     * @param stack Pointer to the ElimStack structure.
+     * @param data The value to store.
+     */
+    if (!stack)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL STACK.\n");
+        return;
+    }
+    struct ElimNode *node = (struct ElimNode *)malloc(sizeof(struct ElimNode));
+    if (node == NULL)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed in elim_stack_push(). Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+    node->data = data;
+
+    for (;;)
+    {
+        struct ElimNode *top = atomic_load(&stack->top);
+        node->next = top;
+        if (atomic_compare_exchange_weak(&stack->top, &top, node))
+        {
+            return;
+        }
+        QUEUE_CONTENTION(stack->contention, CONTENTION_CAS_FAILURE);
+        if (stack->width > 0 && elim_stack_try_push_exchange(stack, data))
+        {
+            free(node);
+            return;
+        }
+    }
+}
+
+bool elim_stack_pop(struct ElimStack *stack, int *out_value)
+{
+    /**
+     * Pops the top element of the stack and stores it in `out_value`.
+     *
+     * Popped nodes are retired to the epoch reclamation module, which also rules out ABA
+     * on `top`: a node cannot be reused while another thread may still compare against it.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     *
+     * @complexity Time complexity: O(1) without contention.
+     *
+     * @param stack Pointer to the ElimStack structure.
+     * @param out_value Pointer to an integer where the removed value will be stored.
+     * @return `true` if an element was removed, `false` if the stack is empty or NULL.
+     */
+    if (!stack)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop from a NULL STACK.\n");
+#endif
+        return false;
+    }
+
+    epoch_enter();
+    for (;;)
+    {
+        struct ElimNode *top = atomic_load(&stack->top);
+        if (top == NULL)
+        {
+            QUEUE_CONTENTION(stack->contention, CONTENTION_EMPTY_STALL);
+            epoch_exit();
+            return false;
+        }
+        if (atomic_compare_exchange_weak(&stack->top, &top, top->next))
+        {
+            *out_value = top->data;
+            epoch_retire(top, sizeof(struct ElimNode), free);
+            epoch_exit();
+            return true;
+        }
+        QUEUE_CONTENTION(stack->contention, CONTENTION_CAS_FAILURE);
+        if (stack->width > 0 && elim_stack_try_pop_exchange(stack, out_value))
+        {
+            epoch_exit();
+            return true;
+        }
+    }
+}
+
+bool elim_stack_is_empty(struct ElimStack *stack)
+{
+    /**
+     * Checks if the stack is empty.
+     *
+     * @note Under concurrent pushes and pops the result is only a snapshot.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param stack Pointer to the ElimStack structure.
+     * @return `true` if the stack is empty or the stack pointer is NULL, `false` otherwise.
+     */
+    return (stack == NULL || atomic_load(&stack->top) == NULL);
+}
+
+bool elim_stack_get_contention(struct ElimStack *stack, int thread_slot, struct ContentionStats *out)
+{
+    /**
+     * Reads the contention counters of the lock-free stack for one thread slot, or summed over all
+     * threads with `thread_slot` -1.
+     *
+     * CAS failures count failed pushes and pops on `top` (each one backs off into the
+     * elimination array); spins count iterations a push waited in an exchange slot;
+     * empty stalls count pops that found the stack empty.
+     *
+     * @note Counting is compiled in with `-DQUEUE_CONTENTION_PROFILE=1` (`make contention`);
+     *       otherwise the call returns `false` and zeroed counters.
+     *
+     * @complexity Time complexity: O(1) for one slot, O(t) for the sum over t slots.
+     *
+     * @param stack Pointer to the ElimStack structure.
+     * @param thread_slot A slot returned by `queue_thread_slot`, or -1 for all threads.
+     * @param out Pointer to the structure that receives the counters.
+     * @return `true` if counters were read, `false` otherwise.
+     */
+#if QUEUE_CONTENTION_PROFILE
+    return contention_profile_get(stack ? stack->contention : NULL, thread_slot, out);
+#else
+    (void)stack;
+    return contention_profile_get(NULL, thread_slot, out);
+#endif
+}
+
+void elim_stack_free(struct ElimStack *stack)
+{
+    /**
+     * Frees the stack and every node still linked in it.
+     *
+     * @note No other thread may access the stack during or after this call.
+     *
+     * @complexity Time complexity: O(n), where n is the number of nodes in the stack.
+     *
+     * @param stack Pointer to the ElimStack structure.
+     */
+    if (!stack)
+    {
+        fprintf(stderr, "INFO: STACK is already NULL. Skipping free.\n");
+        return;
+    }
+    struct ElimNode *iterator = atomic_load(&stack->top);
+    while (iterator != NULL)
+    {
+        struct ElimNode *temp = iterator;
+        iterator = iterator->next;
+        free(temp);
+    }
+#if QUEUE_CONTENTION_PROFILE
+    contention_profile_free(stack->contention);
+#endif
+    free(stack);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Lock-free STACK has been freed.\n");
+#endif
+}
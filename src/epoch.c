@@ -0,0 +1,434 @@
+#define _GNU_SOURCE
+#include <stdatomic.h>
+#include <string.h>
+#include <pthread.h>
+#include "epoch.h"
+#include "queue_clock.h"
+
+struct EpochRetired
+{
+    void *ptr;
+    void (*free_fn)(void *);
+    size_t size;
+    uint64_t epoch;
+    uint64_t retire_ns;
+};
+
+struct EpochRecord
+{
+    _Atomic uint64_t state;
+    atomic_bool in_use;
+    bool online;
+    int nesting;
+    struct EpochRetired *retired;
+    int retired_count;
+    int retired_capacity;
+    _Atomic uint64_t retired_total;
+    _Atomic uint64_t reclaimed_total;
+    _Atomic uint64_t pending_bytes;
+    _Atomic uint64_t list_bytes;
+    _Atomic uint64_t reclaim_batches;
+    _Atomic uint64_t total_reclaim_latency_ns;
+    _Atomic uint64_t max_reclaim_latency_ns;
+    struct EpochRecord *next;
+};
+
+// A record state packs the announced epoch with an "active" flag in the lowest bit
+#define EPOCH_ACTIVE 1ULL
+
+// Cheap monotonic clock used to measure reclaim latency
+#ifdef CLOCK_MONOTONIC_COARSE
+#define EPOCH_CLOCK CLOCK_MONOTONIC_COARSE
+#else
+#define EPOCH_CLOCK CLOCK_MONOTONIC
+#endif
+
+static _Atomic uint64_t global_epoch = 0;
+static _Atomic uint64_t epoch_advances = 0;
+static _Atomic(struct EpochRecord *) epoch_records = NULL;
+static _Thread_local struct EpochRecord *local_record = NULL;
+static pthread_key_t epoch_key;
+static pthread_once_t epoch_key_once = PTHREAD_ONCE_INIT;
+
+static void epoch_release_record(void *arg)
+{
+    /**
+     * Releases the epoch record of a terminating thread.
+     *
+     * Registered as the destructor of `epoch_key`. The record is marked inactive and a
+     * last reclamation pass is attempted; nodes that are not yet safe to free stay in
+     * the record and are inherited by the next thread that acquires it.
+     *
+     * @complexity Time complexity: O(t + r), where t is the number of records and r the
+     *             number of retired nodes.
+     *
+     * @param arg Pointer to the `EpochRecord` owned by the exiting thread.
+     */
+    struct EpochRecord *record = (struct EpochRecord *)arg;
+    record->nesting = 0;
+    record->online = false;
+    atomic_store(&record->state, 0);
+    epoch_reclaim();
+    local_record = NULL;
+    atomic_store(&record->in_use, false);
+}
+
+static void epoch_create_key(void)
+{
+    /**
+     * Creates the thread-specific key used to release records at thread exit.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    pthread_key_create(&epoch_key, epoch_release_record);
+}
+
+static struct EpochRecord *epoch_acquire_record(void)
+{
+    /**
+     * Returns the epoch record of the calling thread, acquiring one on first use.
+     *
+     * Records released by terminated threads are reused before a new one is allocated.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1) after the first call, O(t) on the first call,
+     *             where t is the number of records ever allocated.
+     *
+     * @return Pointer to the `EpochRecord` owned by the calling thread.
+     */
+    if (local_record != NULL)
+    {
+        return local_record;
+    }
+    pthread_once(&epoch_key_once, epoch_create_key);
+
+    struct EpochRecord *record = atomic_load(&epoch_records);
+    while (record != NULL)
+    {
+        bool expected = false;
+        if (!atomic_load(&record->in_use) &&
+            atomic_compare_exchange_strong(&record->in_use, &expected, true))
+        {
+            break;
+        }
+        record = record->next;
+    }
+
+    if (record == NULL)
+    {
+        record = (struct EpochRecord *)calloc(1, sizeof(struct EpochRecord));
+        if (record == NULL)
+        {
+            fprintf(stderr, "ERROR: Memory allocation failed in epoch_acquire_record(). Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+        atomic_store(&record->in_use, true);
+        struct EpochRecord *head = atomic_load(&epoch_records);
+        do
+        {
+            record->next = head;
+        } while (!atomic_compare_exchange_weak(&epoch_records, &head, record));
+#if DEBUG_MODE
+        fprintf(stderr, "INFO: Epoch record allocated.\n");
+#endif
+    }
+
+    local_record = record;
+    pthread_setspecific(epoch_key, record);
+    return record;
+}
+
+static void epoch_announce(struct EpochRecord *record)
+{
+    /**
+     * Publishes the current global epoch as the epoch observed by `record`.
+     *
+     * The full fence orders the announcement before every subsequent load of shared
+     * pointers, so a concurrent `epoch_try_advance` either sees the announcement or the
+     * caller sees every node unlinked before the advance.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    uint64_t epoch = atomic_load(&global_epoch);
+    atomic_store_explicit(&record->state, (epoch << 1) | EPOCH_ACTIVE, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+void epoch_enter(void)
+{
+    /**
+     * Enters an epoch-protected critical section.
+     *
+     * While the calling thread is inside a critical section, no node retired after the
+     * section started is freed. Critical sections may be nested; only the outermost
+     * `epoch_enter` announces the current epoch. Threads that are online in QSBR mode
+     * are always protected, so the call costs nothing for them.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    struct EpochRecord *record = epoch_acquire_record();
+    if (record->nesting++ > 0 || record->online)
+    {
+        return;
+    }
+    epoch_announce(record);
+}
+
+void epoch_exit(void)
+{
+    /**
+     * Leaves an epoch-protected critical section.
+     *
+     * Pointers loaded inside the section must not be dereferenced after the outermost
+     * `epoch_exit`. For threads online in QSBR mode the protection lasts until their next
+     * `epoch_quiescent` instead.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    struct EpochRecord *record = epoch_acquire_record();
+    if (--record->nesting > 0 || record->online)
+    {
+        return;
+    }
+    uint64_t state = atomic_load_explicit(&record->state, memory_order_relaxed);
+    atomic_store_explicit(&record->state, state & ~EPOCH_ACTIVE, memory_order_release);
+}
+
+void epoch_thread_online(void)
+{
+    /**
+     * Switches the calling thread to quiescent-state-based reclamation (QSBR).
+     *
+     * An online thread is considered to be inside a critical section at all times, which
+     * removes the per-operation cost of `epoch_enter`/`epoch_exit`. In exchange it must
+     * call `epoch_quiescent` regularly, typically once per iteration of its worker loop,
+     * when it holds no references to shared nodes. A thread that stays online without
+     * announcing quiescent states blocks reclamation for every thread.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    struct EpochRecord *record = epoch_acquire_record();
+    record->online = true;
+    epoch_announce(record);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Thread switched to quiescent-state-based reclamation.\n");
+#endif
+}
+
+void epoch_thread_offline(void)
+{
+    /**
+     * Takes the calling thread out of QSBR mode, typically before it blocks or exits.
+     *
+     * An offline thread does not hold back reclamation and returns to explicit
+     * `epoch_enter`/`epoch_exit` critical sections.
+     *
+     * @note Must not be called while the thread holds references to shared nodes.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    struct EpochRecord *record = epoch_acquire_record();
+    record->online = false;
+    if (record->nesting > 0)
+    {
+        epoch_announce(record);
+        return;
+    }
+    uint64_t state = atomic_load_explicit(&record->state, memory_order_relaxed);
+    atomic_store_explicit(&record->state, state & ~EPOCH_ACTIVE, memory_order_release);
+}
+
+void epoch_quiescent(void)
+{
+    /**
+     * Announces a quiescent state for the calling thread.
+     *
+     * The thread declares that it holds no references to shared nodes and refreshes its
+     * announced epoch. A reclamation pass runs only when the oldest retired node has
+     * already become safe or a full batch is pending, so announcing a quiescent state once
+     * per iteration of a worker loop stays cheap. Online (QSBR) threads must call it
+     * regularly; for other threads it only triggers reclamation.
+     *
+     * @complexity Time complexity: O(1) when no pass runs, otherwise O(t + r), where t is
+     *             the number of records and r the number of retired nodes.
+     */
+    struct EpochRecord *record = epoch_acquire_record();
+    if (record->online && record->nesting == 0)
+    {
+        epoch_announce(record);
+    }
+    if (record->retired_count >= EPOCH_RETIRE_BATCH ||
+        (record->retired_count > 0 && record->retired[0].epoch + 2 <= atomic_load(&global_epoch)))
+    {
+        epoch_reclaim();
+    }
+}
+
+static bool epoch_try_advance(void)
+{
+    /**
+     * Advances the global epoch if every active thread has observed the current one.
+     *
+     * @complexity Time complexity: O(t), where t is the number of records.
+     *
+     * @return `true` if the global epoch was advanced by this or a concurrent call,
+     *         `false` if some thread is still running in an older epoch.
+     */
+    uint64_t epoch = atomic_load(&global_epoch);
+    for (struct EpochRecord *record = atomic_load(&epoch_records); record != NULL; record = record->next)
+    {
+        uint64_t state = atomic_load(&record->state);
+        if ((state & EPOCH_ACTIVE) && (state >> 1) != epoch)
+        {
+            return false;
+        }
+    }
+    if (atomic_compare_exchange_strong(&global_epoch, &epoch, epoch + 1))
+    {
+        atomic_fetch_add_explicit(&epoch_advances, 1, memory_order_relaxed);
+    }
+    return true;
+}
+
+void epoch_reclaim(void)
+{
+    /**
+     * Frees every node retired by the calling thread that is no longer reachable.
+     *
+     * The function first tries to advance the global epoch and then releases, in one
+     * batch, all retired nodes whose retire epoch is at least two epochs old. Such nodes
+     * cannot be referenced by any thread, since every critical section that could have
+     * observed them has ended. The batch updates the reclaim counters of the record.
+     *
+     * @complexity Time complexity: O(t + r), where t is the number of records and r the
+     *             number of retired nodes.
+     */
+    struct EpochRecord *record = epoch_acquire_record();
+    if (record->retired_count == 0)
+    {
+        return;
+    }
+    epoch_try_advance();
+
+    uint64_t epoch = atomic_load(&global_epoch);
+    int freed = 0;
+    uint64_t freed_bytes = 0;
+    while (freed < record->retired_count && record->retired[freed].epoch + 2 <= epoch)
+    {
+        freed_bytes += record->retired[freed].size;
+        record->retired[freed].free_fn(record->retired[freed].ptr);
+        freed++;
+    }
+    if (freed == 0)
+    {
+        return;
+    }
+
+    uint64_t latency = queue_clock_ns(EPOCH_CLOCK) - record->retired[0].retire_ns;
+    record->retired_count -= freed;
+    memmove(record->retired, record->retired + freed, (size_t)record->retired_count * sizeof(struct EpochRetired));
+
+    atomic_fetch_add_explicit(&record->reclaimed_total, (uint64_t)freed, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&record->pending_bytes, freed_bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&record->reclaim_batches, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&record->total_reclaim_latency_ns, latency, memory_order_relaxed);
+    if (latency > atomic_load_explicit(&record->max_reclaim_latency_ns, memory_order_relaxed))
+    {
+        atomic_store_explicit(&record->max_reclaim_latency_ns, latency, memory_order_relaxed);
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "DEBUG: Epoch %llu reclaimed %d retired nodes, %d pending.\n", (unsigned long long)epoch, freed, record->retired_count);
+#endif
+}
+
+void epoch_retire(void *ptr, size_t size, void (*free_fn)(void *))
+{
+    /**
+     * Defers the release of a node that has been unlinked from a shared structure.
+     *
+     * The node is tagged with the current global epoch and appended to the calling
+     * thread's retire list. Every `EPOCH_RETIRE_BATCH` retirements an `epoch_reclaim`
+     * pass frees the nodes that have become safe.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: amortized O(1 + t / EPOCH_RETIRE_BATCH), where t is
+     *             the number of records.
+     *
+     * @param ptr Pointer to the unlinked node.
+     * @param size Size of the node in bytes, accounted in `EpochStats::pending_bytes`.
+     * @param free_fn Function used to release the node once it is safe to do so.
+     */
+    struct EpochRecord *record = epoch_acquire_record();
+    if (record->retired_count == record->retired_capacity)
+    {
+        int capacity = record->retired_capacity > 0 ? record->retired_capacity * 2 : EPOCH_RETIRE_BATCH;
+        struct EpochRetired *retired = (struct EpochRetired *)realloc(record->retired, (size_t)capacity * sizeof(struct EpochRetired));
+        if (retired == NULL)
+        {
+            fprintf(stderr, "ERROR: Memory allocation failed in epoch_retire(). Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+        record->retired = retired;
+        record->retired_capacity = capacity;
+        atomic_store_explicit(&record->list_bytes, (uint64_t)capacity * sizeof(struct EpochRetired), memory_order_relaxed);
+    }
+    struct EpochRetired *entry = &record->retired[record->retired_count];
+    entry->ptr = ptr;
+    entry->free_fn = free_fn;
+    entry->size = size;
+    entry->epoch = atomic_load(&global_epoch);
+    entry->retire_ns = queue_clock_ns(EPOCH_CLOCK);
+    record->retired_count++;
+    atomic_fetch_add_explicit(&record->retired_total, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&record->pending_bytes, size, memory_order_relaxed);
+
+    if (record->retired_count % EPOCH_RETIRE_BATCH == 0)
+    {
+        epoch_reclaim();
+    }
+}
+
+void epoch_get_stats(struct EpochStats *out)
+{
+    /**
+     * Collects the reclamation counters of all threads into `out`.
+     *
+     * The counters are read without stopping the owning threads, so the result is a
+     * consistent-enough snapshot for monitoring but not an exact instant. `pending` and
+     * `pending_bytes` describe the memory retired but not yet freed, `list_bytes` the
+     * memory used by the retire lists themselves, and the latency counters the time from
+     * retirement to release of the oldest node of each reclaimed batch.
+     *
+     * @complexity Time complexity: O(t), where t is the number of records.
+     *
+     * @param out Pointer to the `EpochStats` structure to fill.
+     */
+    if (!out)
+    {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    out->epoch = atomic_load(&global_epoch);
+    out->advances = atomic_load_explicit(&epoch_advances, memory_order_relaxed);
+    for (struct EpochRecord *record = atomic_load(&epoch_records); record != NULL; record = record->next)
+    {
+        if (atomic_load_explicit(&record->in_use, memory_order_relaxed))
+        {
+            out->threads++;
+        }
+        out->retired += atomic_load_explicit(&record->retired_total, memory_order_relaxed);
+        out->reclaimed += atomic_load_explicit(&record->reclaimed_total, memory_order_relaxed);
+        out->pending_bytes += atomic_load_explicit(&record->pending_bytes, memory_order_relaxed);
+        out->list_bytes += atomic_load_explicit(&record->list_bytes, memory_order_relaxed);
+        out->reclaim_batches += atomic_load_explicit(&record->reclaim_batches, memory_order_relaxed);
+        out->total_reclaim_latency_ns += atomic_load_explicit(&record->total_reclaim_latency_ns, memory_order_relaxed);
+        uint64_t latency = atomic_load_explicit(&record->max_reclaim_latency_ns, memory_order_relaxed);
+        if (latency > out->max_reclaim_latency_ns)
+        {
+            out->max_reclaim_latency_ns = latency;
+        }
+    }
+    out->pending = out->retired > out->reclaimed ? out->retired - out->reclaimed : 0;
+}
@@ -0,0 +1,484 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <sched.h>
+#include "fc_queue.h"
+#include "queue.h"
+#include "thread_slot.h"
+#include "queue_trace.h"
+#include "contention.h"
+
+#define FC_QUEUE_CACHE_LINE 64
+
+// Number of scans over the publication records a combiner performs before releasing the lock
+#define FC_QUEUE_COMBINE_PASSES 2
+
+// Number of busy-wait iterations before a waiting thread yields its CPU
+#define FC_QUEUE_SPINS_BEFORE_YIELD 64
+
+enum FCOperation
+{
+    FC_OP_NONE,
+    FC_OP_PUSH,
+    FC_OP_POP,
+    FC_OP_PUSH_FRONT,
+    FC_OP_POP_BACK,
+    FC_OP_EXECUTE
+};
+
+struct FCRecord
+{
+    alignas(FC_QUEUE_CACHE_LINE) atomic_int operation;
+    int value;
+    bool result;
+    void (*fn)(void *queue, void *arg);
+    void *arg;
+};
+
+struct FCQueue
+{
+    alignas(FC_QUEUE_CACHE_LINE) atomic_bool locked;
+    void *queue;
+    const struct SeqQueueOps *ops;
+#if QUEUE_CONTENTION_PROFILE
+    struct ContentionProfile *contention;
+#endif
+    struct FCRecord records[QUEUE_MAX_THREADS];
+};
+
+static void linked_list_push(void *queue, int data)
+{
+    /**
+     * Adapts `queue_push` to the `SeqQueueOps` interface.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    queue_push((struct LinkedList *)queue, data);
+}
+
+static bool linked_list_pop(void *queue, int *out_value)
+{
+    /**
+     * Adapts `queue_pop` to the `SeqQueueOps` interface, reporting emptiness separately
+     * so that a stored value of -1 is not mistaken for an empty queue.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    struct LinkedList *list = (struct LinkedList *)queue;
+    if (queue_is_empty(list))
+    {
+        return false;
+    }
+    *out_value = queue_pop(list);
+    return true;
+}
+
+static void linked_list_push_front(void *queue, int data)
+{
+    /**
+     * Adapts `queue_push_front` to the `SeqQueueOps` interface.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    queue_push_front((struct LinkedList *)queue, data);
+}
+
+static bool linked_list_pop_back(void *queue, int *out_value)
+{
+    /**
+     * Adapts `queue_pop_back` to the `SeqQueueOps` interface.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    struct LinkedList *list = (struct LinkedList *)queue;
+    if (queue_is_empty(list))
+    {
+        return false;
+    }
+    *out_value = queue_pop_back(list);
+    return true;
+}
+
+const struct SeqQueueOps linked_list_ops = {linked_list_push, linked_list_pop, linked_list_push_front, linked_list_pop_back};
+
+struct FCQueue *fc_queue_create(void *queue, const struct SeqQueueOps *ops)
+{
+    /**
+     * Wraps a sequential queue into a thread-safe flat-combining queue.
+     *
+     * Threads do not lock the sequential queue themselves. Each one publishes its
+     * request in a per-thread record; whichever thread acquires the combiner lock
+     * executes all pending requests in one batch. The data structure therefore stays in
+     * the cache of a single core while the lock is held, and the lock changes hands
+     * once per batch instead of once per operation.
+     *
+     * @note The wrapped queue is not owned by the wrapper; `fc_queue_free` leaves it intact.
+     *
+     * @complexity Time complexity: O(QUEUE_MAX_THREADS).
+     *
+     * @param queue Pointer to the sequential queue, e.g. a `struct LinkedList`.
+     * @param ops Operations of the sequential queue, e.g. `&linked_list_ops`.
+     * @return Pointer to the newly created `FCQueue` structure, or NULL if creation fails.
+     */
+    if (!queue || !ops)
+    {
+        fprintf(stderr, "ERROR: Cannot wrap a NULL QUEUE.\n");
+        return NULL;
+    }
+    struct FCQueue *fc = (struct FCQueue *)aligned_alloc(FC_QUEUE_CACHE_LINE, sizeof(struct FCQueue));
+    if (!fc)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for FCQueue.\n");
+        return NULL;
+    }
+    atomic_init(&fc->locked, false);
+    fc->queue = queue;
+    fc->ops = ops;
+#if QUEUE_CONTENTION_PROFILE
+    fc->contention = contention_profile_create();
+#endif
+    for (int i = 0; i < QUEUE_MAX_THREADS; i++)
+    {
+        atomic_init(&fc->records[i].operation, FC_OP_NONE);
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Flat-combining QUEUE initialized.\n");
+#endif
+    return fc;
+}
+
+static void fc_queue_apply(struct FCQueue *fc, struct FCRecord *record, int operation)
+{
+    /**
+     * Executes one published request on the sequential queue.
+     *
+     * @note Must only be called by the thread holding the combiner lock.
+     *
+     * @complexity Time complexity: the cost of the underlying operation.
+     */
+    switch (operation)
+    {
+    case FC_OP_PUSH:
+        fc->ops->push(fc->queue, record->value);
+        break;
+    case FC_OP_POP:
+        record->result = fc->ops->pop(fc->queue, &record->value);
+        break;
+    case FC_OP_PUSH_FRONT:
+        fc->ops->push_front(fc->queue, record->value);
+        break;
+    case FC_OP_POP_BACK:
+        record->result = fc->ops->pop_back(fc->queue, &record->value);
+        break;
+    case FC_OP_EXECUTE:
+        record->fn(fc->queue, record->arg);
+        break;
+    default:
+        break;
+    }
+}
+
+static void fc_queue_combine(struct FCQueue *fc)
+{
+    /**
+     * Executes every pending request of every thread in a batch.
+     *
+     * The records are scanned `FC_QUEUE_COMBINE_PASSES` times so requests published
+     * while the first pass runs are served without another lock handover.
+     *
+     * @note Must only be called by the thread holding the combiner lock.
+     *
+     * @complexity Time complexity: O(p * t + k), where p is `FC_QUEUE_COMBINE_PASSES`,
+     *             t the number of thread slots in use and k the cost of the batch.
+     */
+    for (int pass = 0; pass < FC_QUEUE_COMBINE_PASSES; pass++)
+    {
+        int limit = queue_thread_slot_limit();
+        for (int i = 0; i < limit; i++)
+        {
+            struct FCRecord *record = &fc->records[i];
+            int operation = atomic_load_explicit(&record->operation, memory_order_acquire);
+            if (operation != FC_OP_NONE)
+            {
+                fc_queue_apply(fc, record, operation);
+                atomic_store_explicit(&record->operation, FC_OP_NONE, memory_order_release);
+            }
+        }
+    }
+}
+
+static void fc_queue_lock(struct FCQueue *fc)
+{
+    /**
+     * Acquires the combiner lock, yielding the CPU while it is contended.
+     *
+     * @complexity Time complexity: O(1) without contention.
+     */
+    int spins = 0;
+    while (atomic_load_explicit(&fc->locked, memory_order_relaxed) ||
+           atomic_exchange_explicit(&fc->locked, true, memory_order_acquire))
+    {
+        QUEUE_CONTENTION(fc->contention, CONTENTION_SPIN);
+        if (++spins % FC_QUEUE_SPINS_BEFORE_YIELD == 0)
+        {
+            QUEUE_CONTENTION(fc->contention, CONTENTION_YIELD);
+            sched_yield();
+        }
+    }
+    if (spins > 0)
+    {
+        QUEUE_TRACE2(fc_queue_lock_wait, (intptr_t)fc, spins);
+    }
+}
+
+static void fc_queue_submit(struct FCQueue *fc, struct FCRecord *request, int operation)
+{
+    /**
+     * Publishes a request and waits until it has been executed by a combiner.
+     *
+     * The calling thread becomes the combiner itself whenever the lock is free, so a
+     * request never waits for a combiner that does not exist. Threads without a thread
+     * slot fall back to executing their request under the lock directly.
+     *
+     * @complexity Time complexity: O(1) amortized per request without contention.
+     *
+     * @param fc Pointer to the FCQueue structure.
+     * @param request Request arguments; results are copied back into it.
+     * @param operation One of the `FCOperation` values other than `FC_OP_NONE`.
+     */
+    int slot = queue_thread_slot();
+    if (slot < 0)
+    {
+        fc_queue_lock(fc);
+        fc_queue_apply(fc, request, operation);
+        atomic_store_explicit(&fc->locked, false, memory_order_release);
+        return;
+    }
+
+    struct FCRecord *record = &fc->records[slot];
+    record->value = request->value;
+    record->fn = request->fn;
+    record->arg = request->arg;
+    atomic_store_explicit(&record->operation, operation, memory_order_release);
+
+    int spins = 0;
+    while (atomic_load_explicit(&record->operation, memory_order_acquire) != FC_OP_NONE)
+    {
+        if (!atomic_load_explicit(&fc->locked, memory_order_relaxed) &&
+            !atomic_exchange_explicit(&fc->locked, true, memory_order_acquire))
+        {
+            fc_queue_combine(fc);
+            atomic_store_explicit(&fc->locked, false, memory_order_release);
+            continue;
+        }
+        QUEUE_CONTENTION(fc->contention, CONTENTION_SPIN);
+        if (++spins % FC_QUEUE_SPINS_BEFORE_YIELD == 0)
+        {
+            QUEUE_CONTENTION(fc->contention, CONTENTION_YIELD);
+            sched_yield();
+        }
+    }
+    if (spins > 0)
+    {
+        QUEUE_TRACE2(fc_queue_wait, (intptr_t)fc, spins);
+    }
+    request->value = record->value;
+    request->result = record->result;
+}
+
+void fc_queue_push(struct FCQueue *fc, int data)
+{
+    /**
+     * Adds the given data at the tail of the wrapped queue.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     *
+     * @complexity Time complexity: the cost of the underlying push, plus the wait for
+     *             the current batch.
+     *
+     * @param fc Pointer to the FCQueue structure.
+     * @param data The value to store.
+     */
+    if (!fc)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return;
+    }
+    struct FCRecord request = {.value = data};
+    fc_queue_submit(fc, &request, FC_OP_PUSH);
+}
+
+bool fc_queue_pop(struct FCQueue *fc, int *out_value)
+{
+    /**
+     * Removes the front element of the wrapped queue and stores it in `out_value`.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     *
+     * @complexity Time complexity: the cost of the underlying pop, plus the wait for
+     *             the current batch.
+     *
+     * @param fc Pointer to the FCQueue structure.
+     * @param out_value Pointer to an integer where the removed value will be stored.
+     * @return `true` if an element was removed, `false` if the queue is empty or NULL.
+     */
+    if (!fc)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop from a NULL QUEUE.\n");
+#endif
+        return false;
+    }
+    struct FCRecord request = {.result = false};
+    fc_queue_submit(fc, &request, FC_OP_POP);
+    if (request.result)
+    {
+        *out_value = request.value;
+    }
+    else
+    {
+        QUEUE_CONTENTION(fc->contention, CONTENTION_EMPTY_STALL);
+    }
+    return request.result;
+}
+
+void fc_queue_push_front(struct FCQueue *fc, int data)
+{
+    /**
+     * Adds the given data at the front of the wrapped queue.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     * @note The wrapped queue must provide `push_front` in its `SeqQueueOps`.
+     *
+     * @complexity Time complexity: the cost of the underlying push_front, plus the wait
+     *             for the current batch.
+     *
+     * @param fc Pointer to the FCQueue structure.
+     * @param data The value to store.
+     */
+    if (!fc || !fc->ops->push_front)
+    {
+        fprintf(stderr, "ERROR: Attempt to push_front to a NULL or single-ended QUEUE.\n");
+        return;
+    }
+    struct FCRecord request = {.value = data};
+    fc_queue_submit(fc, &request, FC_OP_PUSH_FRONT);
+}
+
+bool fc_queue_pop_back(struct FCQueue *fc, int *out_value)
+{
+    /**
+     * Removes the back element of the wrapped queue and stores it in `out_value`.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     * @note The wrapped queue must provide `pop_back` in its `SeqQueueOps`.
+     *
+     * @complexity Time complexity: the cost of the underlying pop_back, plus the wait
+     *             for the current batch.
+     *
+     * @param fc Pointer to the FCQueue structure.
+     * @param out_value Pointer to an integer where the removed value will be stored.
+     * @return `true` if an element was removed, `false` if the queue is empty, NULL or
+     *         single-ended.
+     */
+    if (!fc || !fc->ops->pop_back)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop_back from a NULL or single-ended QUEUE.\n");
+#endif
+        return false;
+    }
+    struct FCRecord request = {.result = false};
+    fc_queue_submit(fc, &request, FC_OP_POP_BACK);
+    if (request.result)
+    {
+        *out_value = request.value;
+    }
+    else
+    {
+        QUEUE_CONTENTION(fc->contention, CONTENTION_EMPTY_STALL);
+    }
+    return request.result;
+}
+
+void fc_queue_execute(struct FCQueue *fc, void (*fn)(void *queue, void *arg), void *arg)
+{
+    /**
+     * Runs an arbitrary operation on the wrapped queue with exclusive access.
+     *
+     * This is how rich sequential operations such as `queue_search` or removal from the
+     * middle are made thread-safe: `fn` is executed by the combiner in the same batch as
+     * pushes and pops, and the call returns once it has completed.
+     *
+     * @note `fn` must not call back into the same `FCQueue`.
+     *
+     * @complexity Time complexity: the cost of `fn`, plus the wait for the current batch.
+     *
+     * @param fc Pointer to the FCQueue structure.
+     * @param fn Operation to run; receives the wrapped queue and `arg`.
+     * @param arg Argument forwarded to `fn`, typically a struct holding inputs and outputs.
+     */
+    if (!fc || !fn)
+    {
+        fprintf(stderr, "ERROR: Attempt to execute on a NULL QUEUE.\n");
+        return;
+    }
+    struct FCRecord request = {.fn = fn, .arg = arg};
+    fc_queue_submit(fc, &request, FC_OP_EXECUTE);
+}
+
+bool fc_queue_get_contention(struct FCQueue *fc, int thread_slot, struct ContentionStats *out)
+{
+    /**
+     * Reads the contention counters of the flat-combining wrapper for one thread slot, or summed over all
+     * threads with `thread_slot` -1.
+     *
+     * Spins count busy-wait iterations for the combiner lock or for a combiner to serve
+     * the request, and yields the times a waiter gave up its CPU; empty stalls count pops
+     * that found the wrapped queue empty. The combiner lock is taken with an exchange,
+     * so there are no CAS failures.
+     *
+     * @note Counting is compiled in with `-DQUEUE_CONTENTION_PROFILE=1` (`make contention`);
+     *       otherwise the call returns `false` and zeroed counters.
+     *
+     * @complexity Time complexity: O(1) for one slot, O(t) for the sum over t slots.
+     *
+     * @param fc Pointer to the FCQueue structure.
+     * @param thread_slot A slot returned by `queue_thread_slot`, or -1 for all threads.
+     * @param out Pointer to the structure that receives the counters.
+     * @return `true` if counters were read, `false` otherwise.
+     */
+#if QUEUE_CONTENTION_PROFILE
+    return contention_profile_get(fc ? fc->contention : NULL, thread_slot, out);
+#else
+    (void)fc;
+    return contention_profile_get(NULL, thread_slot, out);
+#endif
+}
+
+void fc_queue_free(struct FCQueue *fc)
+{
+    /**
+     * Frees the flat-combining wrapper.
+     *
+     * The wrapped sequential queue is left untouched and must be freed by its owner.
+     *
+     * @note No other thread may access the wrapper during or after this call.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param fc Pointer to the FCQueue structure.
+     */
+    if (!fc)
+    {
+        fprintf(stderr, "INFO: QUEUE is already NULL. Skipping free.\n");
+        return;
+    }
+#if QUEUE_CONTENTION_PROFILE
+    contention_profile_free(fc->contention);
+#endif
+    free(fc);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Flat-combining QUEUE has been freed.\n");
+#endif
+}
@@ -0,0 +1,281 @@
+#include <stdatomic.h>
+#include <pthread.h>
+#include "hazard.h"
+
+struct HazardRetired
+{
+    void *ptr;
+    void (*free_fn)(void *);
+};
+
+struct HazardRecord
+{
+    _Atomic(void *) slots[HAZARD_SLOTS_PER_THREAD];
+    atomic_bool in_use;
+    struct HazardRetired *retired;
+    int retired_count;
+    int retired_capacity;
+    struct HazardRecord *next;
+};
+
+static _Atomic(struct HazardRecord *) hazard_records = NULL;
+static atomic_int hazard_record_count = 0;
+static _Thread_local struct HazardRecord *local_record = NULL;
+static pthread_key_t hazard_key;
+static pthread_once_t hazard_key_once = PTHREAD_ONCE_INIT;
+
+static void hazard_release_record(void *arg)
+{
+    /**
+     * Releases the hazard record of a terminating thread.
+     *
+     * Registered as the destructor of `hazard_key`, so it runs automatically when a
+     * thread that used hazard pointers exits. All slots are cleared and a final scan
+     * is attempted; nodes that are still protected by other threads stay in the
+     * record and are inherited by the next thread that acquires it.
+     *
+     * @complexity Time complexity: O(r log h), where r is the number of retired nodes
+     *             and h the number of published hazard pointers.
+     *
+     * @param arg Pointer to the `HazardRecord` owned by the exiting thread.
+     */
+    struct HazardRecord *record = (struct HazardRecord *)arg;
+    for (int i = 0; i < HAZARD_SLOTS_PER_THREAD; i++)
+    {
+        atomic_store(&record->slots[i], NULL);
+    }
+    hazard_scan();
+    local_record = NULL;
+    atomic_store(&record->in_use, false);
+}
+
+static void hazard_create_key(void)
+{
+    /**
+     * Creates the thread-specific key used to release records at thread exit.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    pthread_key_create(&hazard_key, hazard_release_record);
+}
+
+static struct HazardRecord *hazard_acquire_record(void)
+{
+    /**
+     * Returns the hazard record of the calling thread, acquiring one on first use.
+     *
+     * Records released by terminated threads are reused before a new one is allocated,
+     * so the global record list only grows up to the peak number of concurrent threads.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1) after the first call, O(t) on the first call,
+     *             where t is the number of records ever allocated.
+     *
+     * @return Pointer to the `HazardRecord` owned by the calling thread.
+     */
+    if (local_record != NULL)
+    {
+        return local_record;
+    }
+    pthread_once(&hazard_key_once, hazard_create_key);
+
+    struct HazardRecord *record = atomic_load(&hazard_records);
+    while (record != NULL)
+    {
+        bool expected = false;
+        if (!atomic_load(&record->in_use) &&
+            atomic_compare_exchange_strong(&record->in_use, &expected, true))
+        {
+            break;
+        }
+        record = record->next;
+    }
+
+    if (record == NULL)
+    {
+        record = (struct HazardRecord *)calloc(1, sizeof(struct HazardRecord));
+        if (record == NULL)
+        {
+            fprintf(stderr, "ERROR: Memory allocation failed in hazard_acquire_record(). Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+        atomic_store(&record->in_use, true);
+        struct HazardRecord *head = atomic_load(&hazard_records);
+        do
+        {
+            record->next = head;
+        } while (!atomic_compare_exchange_weak(&hazard_records, &head, record));
+        atomic_fetch_add(&hazard_record_count, 1);
+#if DEBUG_MODE
+        fprintf(stderr, "INFO: Hazard record allocated (%d records in total).\n", atomic_load(&hazard_record_count));
+#endif
+    }
+
+    local_record = record;
+    pthread_setspecific(hazard_key, record);
+    return record;
+}
+
+void hazard_set(int slot, void *ptr)
+{
+    /**
+     * Publishes `ptr` in one of the calling thread's hazard slots.
+     *
+     * A node published in a hazard slot is never freed by `hazard_scan`. The caller must
+     * re-read the shared location after publishing and retry if it changed, because the
+     * node may have been retired between the first read and the publication.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param slot Index of the hazard slot, in `[0, HAZARD_SLOTS_PER_THREAD)`.
+     * @param ptr Pointer to protect, or NULL to clear the slot.
+     */
+    struct HazardRecord *record = hazard_acquire_record();
+    atomic_store(&record->slots[slot], ptr);
+}
+
+void hazard_clear(int slot)
+{
+    /**
+     * Clears one of the calling thread's hazard slots.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param slot Index of the hazard slot, in `[0, HAZARD_SLOTS_PER_THREAD)`.
+     */
+    struct HazardRecord *record = hazard_acquire_record();
+    atomic_store_explicit(&record->slots[slot], NULL, memory_order_release);
+}
+
+void hazard_clear_all(void)
+{
+    /**
+     * Clears every hazard slot of the calling thread.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    struct HazardRecord *record = hazard_acquire_record();
+    for (int i = 0; i < HAZARD_SLOTS_PER_THREAD; i++)
+    {
+        atomic_store_explicit(&record->slots[i], NULL, memory_order_release);
+    }
+}
+
+static int hazard_compare(const void *a, const void *b)
+{
+    /**
+     * Orders two hazard pointers by address, for use with `qsort` and `bsearch`.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    const char *left = *(const char *const *)a;
+    const char *right = *(const char *const *)b;
+    return (left > right) - (left < right);
+}
+
+void hazard_scan(void)
+{
+    /**
+     * Frees every node retired by the calling thread that no thread currently protects.
+     *
+     * The function snapshots the hazard slots of all records, sorts them and checks each
+     * retired node against the snapshot. Unprotected nodes are released through their
+     * `free_fn`; protected ones stay in the retire list for a later scan.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(r log h + h log h), where r is the number of retired
+     *             nodes and h the number of published hazard pointers.
+     */
+    struct HazardRecord *self = hazard_acquire_record();
+    if (self->retired_count == 0)
+    {
+        return;
+    }
+
+    int capacity = atomic_load(&hazard_record_count) * HAZARD_SLOTS_PER_THREAD;
+    void **hazards = (void **)malloc((size_t)(capacity > 0 ? capacity : 1) * sizeof(void *));
+    if (hazards == NULL)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed in hazard_scan(). Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int count = 0;
+    for (struct HazardRecord *record = atomic_load(&hazard_records); record != NULL; record = record->next)
+    {
+        for (int i = 0; i < HAZARD_SLOTS_PER_THREAD && count < capacity; i++)
+        {
+            void *ptr = atomic_load(&record->slots[i]);
+            if (ptr != NULL)
+            {
+                hazards[count++] = ptr;
+            }
+        }
+    }
+    qsort(hazards, (size_t)count, sizeof(void *), hazard_compare);
+
+    int kept = 0;
+    for (int i = 0; i < self->retired_count; i++)
+    {
+        struct HazardRetired retired = self->retired[i];
+        if (count > 0 && bsearch(&retired.ptr, hazards, (size_t)count, sizeof(void *), hazard_compare) != NULL)
+        {
+            self->retired[kept++] = retired;
+        }
+        else
+        {
+            retired.free_fn(retired.ptr);
+        }
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "DEBUG: Hazard scan freed %d of %d retired nodes.\n", self->retired_count - kept, self->retired_count);
+#endif
+    self->retired_count = kept;
+    free(hazards);
+}
+
+void hazard_retire(void *ptr, void (*free_fn)(void *))
+{
+    /**
+     * Defers the release of a node that has been unlinked from a shared structure.
+     *
+     * The node is appended to the calling thread's retire list. Once the list holds
+     * more than `max(HAZARD_RETIRE_BATCH, 2 * H)` entries, where H is the total number
+     * of hazard slots, a `hazard_scan` reclaims the whole batch at once.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: amortized O(log h) per retired node.
+     *
+     * @param ptr Pointer to the unlinked node.
+     * @param free_fn Function used to release the node once it is safe to do so.
+     */
+    struct HazardRecord *record = hazard_acquire_record();
+    if (record->retired_count == record->retired_capacity)
+    {
+        int capacity = record->retired_capacity > 0 ? record->retired_capacity * 2 : HAZARD_RETIRE_BATCH;
+        struct HazardRetired *retired = (struct HazardRetired *)realloc(record->retired, (size_t)capacity * sizeof(struct HazardRetired));
+        if (retired == NULL)
+        {
+            fprintf(stderr, "ERROR: Memory allocation failed in hazard_retire(). Exiting...\n");
+            exit(EXIT_FAILURE);
+        }
+        record->retired = retired;
+        record->retired_capacity = capacity;
+    }
+    record->retired[record->retired_count].ptr = ptr;
+    record->retired[record->retired_count].free_fn = free_fn;
+    record->retired_count++;
+
+    int threshold = 2 * HAZARD_SLOTS_PER_THREAD * atomic_load(&hazard_record_count);
+    if (threshold < HAZARD_RETIRE_BATCH)
+    {
+        threshold = HAZARD_RETIRE_BATCH;
+    }
+    if (record->retired_count >= threshold)
+    {
+        hazard_scan();
+    }
+}
@@ -0,0 +1,428 @@
+#include <stdatomic.h>
+#include <stdalign.h>
+#include "ms_queue.h"
+#include "hazard.h"
+#include "epoch.h"
+#include "contention.h"
+
+#define MS_QUEUE_CACHE_LINE 64
+
+struct MSNode
+{
+    int data;
+    _Atomic(struct MSNode *) next;
+};
+
+struct MSQueue
+{
+    alignas(MS_QUEUE_CACHE_LINE) _Atomic(struct MSNode *) head;
+    alignas(MS_QUEUE_CACHE_LINE) _Atomic(struct MSNode *) tail;
+    alignas(MS_QUEUE_CACHE_LINE) enum MSQueueReclaim reclaim;
+#if QUEUE_CONTENTION_PROFILE
+    struct ContentionProfile *contention;
+#endif
+};
+
+static struct MSNode *ms_node_create(int data)
+{
+    /**
+     * Allocates a node holding `data` with a NULL successor.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param data The value to store in the node.
+     * @return Pointer to the newly allocated node.
+     */
+    struct MSNode *node = (struct MSNode *)malloc(sizeof(struct MSNode));
+    if (node == NULL)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed in ms_node_create(). Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+    node->data = data;
+    atomic_init(&node->next, NULL);
+    return node;
+}
+
+struct MSQueue *ms_queue_create(enum MSQueueReclaim reclaim)
+{
+    /**
+     * Allocates and initializes a new Michael-Scott lock-free queue.
+     *
+     * The queue always holds a dummy node at its head, so `head` and `tail` are never NULL
+     * and producers and consumers only contend when the queue is nearly empty. Nodes
+     * unlinked by `ms_queue_pop` are handed to the selected reclamation scheme and freed
+     * in batches once no thread can still access them.
+     *
+     * @note The created queue must be released with `ms_queue_free` to avoid memory leaks.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param reclaim Reclamation scheme, `MS_QUEUE_RECLAIM_HAZARD` or `MS_QUEUE_RECLAIM_EPOCH`.
+     * @return Pointer to the newly created `MSQueue` structure, or NULL if creation fails.
+     */
+    size_t size = (sizeof(struct MSQueue) + MS_QUEUE_CACHE_LINE - 1) / MS_QUEUE_CACHE_LINE * MS_QUEUE_CACHE_LINE;
+    struct MSQueue *queue = (struct MSQueue *)aligned_alloc(MS_QUEUE_CACHE_LINE, size);
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for MSQueue.\n");
+        return NULL;
+    }
+
+    struct MSNode *dummy = ms_node_create(0);
+    atomic_init(&queue->head, dummy);
+    atomic_init(&queue->tail, dummy);
+    queue->reclaim = reclaim;
+#if QUEUE_CONTENTION_PROFILE
+    queue->contention = contention_profile_create();
+#endif
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Lock-free QUEUE initialized with %s reclamation.\n", reclaim == MS_QUEUE_RECLAIM_HAZARD ? "hazard pointer" : "epoch-based");
+#endif
+    return queue;
+}
+
+static void ms_queue_enter(struct MSQueue *queue)
+{
+    /**
+     * Starts a protected access to the queue for the configured reclamation scheme.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    if (queue->reclaim == MS_QUEUE_RECLAIM_EPOCH)
+    {
+        epoch_enter();
+    }
+}
+
+static void ms_queue_exit(struct MSQueue *queue)
+{
+    /**
+     * Ends a protected access to the queue for the configured reclamation scheme.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    if (queue->reclaim == MS_QUEUE_RECLAIM_EPOCH)
+    {
+        epoch_exit();
+    }
+    else
+    {
+        hazard_clear_all();
+    }
+}
+
+static struct MSNode *ms_queue_protect(struct MSQueue *queue, int slot, _Atomic(struct MSNode *) *source)
+{
+    /**
+     * Loads a node pointer from `source` and protects it from reclamation.
+     *
+     * With hazard pointers the loaded node is published in `slot` and the load is repeated
+     * until it is stable, which guarantees the node had not been retired at publication
+     * time. With epochs the enclosing critical section already protects it.
+     *
+     * @complexity Time complexity: O(1) expected.
+     *
+     * @param queue Pointer to the MSQueue structure.
+     * @param slot Hazard slot used for the protection.
+     * @param source Shared location to load the node pointer from.
+     * @return The protected node pointer.
+     */
+    struct MSNode *node = atomic_load(source);
+    if (queue->reclaim == MS_QUEUE_RECLAIM_EPOCH)
+    {
+        return node;
+    }
+    for (;;)
+    {
+        hazard_set(slot, node);
+        struct MSNode *again = atomic_load(source);
+        if (again == node)
+        {
+            return node;
+        }
+        QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+        node = again;
+    }
+}
+
+void ms_queue_push(struct MSQueue *queue, int data)
+{
+    /**
+     * Adds a new node with the given data at the tail of the lock-free queue.
+     *
+     * The node is linked with a CAS on the `next` pointer of the last node; the `tail`
+     * pointer is swung afterwards and may be helped forward by other threads that find
+     * it lagging behind.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1) without contention.
+     *
+     * @param queue Pointer to the MSQueue structure.
+     * @param data The value to store in the newly created node.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return;
+    }
+    struct MSNode *node = ms_node_create(data);
+
+    ms_queue_enter(queue);
+    for (;;)
+    {
+        struct MSNode *tail = ms_queue_protect(queue, 0, &queue->tail);
+        struct MSNode *next = atomic_load(&tail->next);
+        if (tail != atomic_load(&queue->tail))
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            continue;
+        }
+        if (next != NULL)
+        {
+            if (!atomic_compare_exchange_weak(&queue->tail, &tail, next))
+            {
+                QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+            }
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            continue;
+        }
+        if (atomic_compare_exchange_weak(&tail->next, &next, node))
+        {
+            atomic_compare_exchange_strong(&queue->tail, &tail, node);
+            break;
+        }
+        QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+    }
+    ms_queue_exit(queue);
+}
+
+void ms_queue_push_bulk(struct MSQueue *queue, const int *values, int count)
+{
+    /**
+     * Adds `count` values at the tail of the lock-free queue with a single linking CAS.
+     *
+     * The nodes are first chained privately, then the whole chain is attached to the last
+     * node with one CAS, exactly like a single node in `ms_queue_push`. Consumers see the
+     * values in order, and the shared `tail` pointer is swung to the end of the chain
+     * afterwards (other threads finding it lagging help it forward node by node).
+     *
+     * @note Safe to call concurrently from any number of threads.
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(k), where k is `count`, with one contended CAS.
+     *
+     * @param queue Pointer to the MSQueue structure.
+     * @param values Pointer to the values to store.
+     * @param count Number of values.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return;
+    }
+    if (!values || count <= 0)
+    {
+        return;
+    }
+    struct MSNode *first = ms_node_create(values[0]);
+    struct MSNode *last = first;
+    for (int i = 1; i < count; i++)
+    {
+        struct MSNode *node = ms_node_create(values[i]);
+        atomic_store_explicit(&last->next, node, memory_order_relaxed);
+        last = node;
+    }
+
+    ms_queue_enter(queue);
+    for (;;)
+    {
+        struct MSNode *tail = ms_queue_protect(queue, 0, &queue->tail);
+        struct MSNode *next = atomic_load(&tail->next);
+        if (tail != atomic_load(&queue->tail))
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            continue;
+        }
+        if (next != NULL)
+        {
+            if (!atomic_compare_exchange_weak(&queue->tail, &tail, next))
+            {
+                QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+            }
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            continue;
+        }
+        if (atomic_compare_exchange_weak(&tail->next, &next, first))
+        {
+            atomic_compare_exchange_strong(&queue->tail, &tail, last);
+            break;
+        }
+        QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+    }
+    ms_queue_exit(queue);
+}
+
+bool ms_queue_pop(struct MSQueue *queue, int *out_value)
+{
+    /**
+     * Removes the front element of the lock-free queue and stores it in `out_value`.
+     *
+     * The old dummy node is unlinked by advancing `head` and retired through the queue's
+     * reclamation scheme instead of being freed immediately, since concurrent threads may
+     * still be reading it.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     *
+     * @complexity Time complexity: O(1) without contention.
+     *
+     * @param queue Pointer to the MSQueue structure.
+     * @param out_value Pointer to an integer where the removed value will be stored.
+     * @return `true` if an element was removed, `false` if the queue is empty or NULL.
+     */
+    if (!queue)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop from a NULL QUEUE.\n");
+#endif
+        return false;
+    }
+
+    struct MSNode *head;
+    ms_queue_enter(queue);
+    for (;;)
+    {
+        head = ms_queue_protect(queue, 0, &queue->head);
+        struct MSNode *tail = atomic_load(&queue->tail);
+        struct MSNode *next = ms_queue_protect(queue, 1, &head->next);
+        if (head != atomic_load(&queue->head))
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            continue;
+        }
+        if (next == NULL)
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_EMPTY_STALL);
+            ms_queue_exit(queue);
+            return false;
+        }
+        if (head == tail)
+        {
+            if (!atomic_compare_exchange_weak(&queue->tail, &tail, next))
+            {
+                QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+            }
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            continue;
+        }
+        int data = next->data;
+        if (atomic_compare_exchange_weak(&queue->head, &head, next))
+        {
+            *out_value = data;
+            break;
+        }
+        QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+    }
+
+    if (queue->reclaim == MS_QUEUE_RECLAIM_EPOCH)
+    {
+        epoch_retire(head, sizeof(struct MSNode), free);
+        epoch_exit();
+    }
+    else
+    {
+        hazard_clear_all();
+        hazard_retire(head, free);
+    }
+    return true;
+}
+
+bool ms_queue_is_empty(struct MSQueue *queue)
+{
+    /**
+     * Checks if the lock-free queue is empty.
+     *
+     * @note Under concurrent pushes and pops the result is only a snapshot.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the MSQueue structure.
+     * @return `true` if the queue is empty or the queue pointer is NULL, `false` otherwise.
+     */
+    if (!queue)
+    {
+        return true;
+    }
+    ms_queue_enter(queue);
+    struct MSNode *head = ms_queue_protect(queue, 0, &queue->head);
+    bool empty = atomic_load(&head->next) == NULL;
+    ms_queue_exit(queue);
+    return empty;
+}
+
+bool ms_queue_get_contention(struct MSQueue *queue, int thread_slot, struct ContentionStats *out)
+{
+    /**
+     * Reads the contention counters of the lock-free queue for one thread slot, or summed over all
+     * threads with `thread_slot` -1.
+     *
+     * CAS failures count failed links, head advances and tail swings; spins count loop
+     * retries (inconsistent snapshots, helping a lagging tail, unstable hazard loads);
+     * empty stalls count pops that found the queue empty.
+     *
+     * @note Counting is compiled in with `-DQUEUE_CONTENTION_PROFILE=1` (`make contention`);
+     *       otherwise the call returns `false` and zeroed counters.
+     *
+     * @complexity Time complexity: O(1) for one slot, O(t) for the sum over t slots.
+     *
+     * @param queue Pointer to the MSQueue structure.
+     * @param thread_slot A slot returned by `queue_thread_slot`, or -1 for all threads.
+     * @param out Pointer to the structure that receives the counters.
+     * @return `true` if counters were read, `false` otherwise.
+     */
+#if QUEUE_CONTENTION_PROFILE
+    return contention_profile_get(queue ? queue->contention : NULL, thread_slot, out);
+#else
+    (void)queue;
+    return contention_profile_get(NULL, thread_slot, out);
+#endif
+}
+
+void ms_queue_free(struct MSQueue *queue)
+{
+    /**
+     * Frees the lock-free queue and every node still linked in it.
+     *
+     * Nodes that were already retired by `ms_queue_pop` are owned by the reclamation
+     * scheme and are released by it.
+     *
+     * @note No other thread may access the queue during or after this call.
+     *
+     * @complexity Time complexity: O(n), where n is the number of nodes in the queue.
+     *
+     * @param queue Pointer to the MSQueue structure.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "INFO: QUEUE is already NULL. Skipping free.\n");
+        return;
+    }
+    struct MSNode *iterator = atomic_load(&queue->head);
+    while (iterator != NULL)
+    {
+        struct MSNode *temp = iterator;
+        iterator = atomic_load(&iterator->next);
+        free(temp);
+    }
+#if QUEUE_CONTENTION_PROFILE
+    contention_profile_free(queue->contention);
+#endif
+    free(queue);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Lock-free QUEUE has been freed.\n");
+#endif
+}
@@ -0,0 +1,697 @@
+#define _GNU_SOURCE
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "pipeline.h"
+#include "queue_clock.h"
+#include "affinity.h"
+#include "queue_trace.h"
+
+#define PIPELINE_CACHE_LINE 64
+
+// Empty polls or blocked pushes that yield the CPU before a waiting thread starts to sleep
+#define PIPELINE_YIELDS_BEFORE_SLEEP 64
+#define PIPELINE_SLEEP_NS 50000
+
+// Values a stage thread has emitted but not yet pushed to one output queue
+struct PipelineOutputBuffer
+{
+    int *values;
+    int count;
+};
+
+struct PipelineEmitter
+{
+    struct PipelineWorker *worker;
+    struct PipelineOutputBuffer outputs[PIPELINE_MAX_OUTPUTS];
+};
+
+// One thread of a stage with its counters, on their own cache line since only the thread writes them
+struct PipelineWorker
+{
+    alignas(PIPELINE_CACHE_LINE) struct Pipeline *pipeline;
+    int stage;
+    int cpu;
+    pthread_t thread;
+    struct PipelineEmitter emitter;
+    _Atomic uint64_t consumed;
+    _Atomic uint64_t emitted;
+    _Atomic uint64_t batches;
+    _Atomic uint64_t full_stalls;
+    _Atomic uint64_t empty_polls;
+    _Atomic uint64_t busy_ns;
+};
+
+struct PipelineStage
+{
+    const char *name;
+    PipelineStageFn fn;
+    void *context;
+    int thread_count;
+    int cpu;
+    struct BoundedQueue *input;
+    int outputs[PIPELINE_MAX_OUTPUTS];
+    int output_count;
+    int upstream_count;
+    struct PipelineWorker *workers;
+    _Atomic int producers_open;
+    _Atomic int threads_running;
+    _Atomic uint64_t end_ns;
+};
+
+struct Pipeline
+{
+    struct PipelineStage stages[PIPELINE_MAX_STAGES];
+    int stage_count;
+    int queue_capacity;
+    int batch_size;
+    bool started;
+    bool closed;
+    bool joined;
+    uint64_t start_ns;
+};
+
+static void pipeline_count(_Atomic uint64_t *counter, uint64_t amount)
+{
+    /**
+     * Adds `amount` to a per-thread counter. Only the owning thread writes it, so a
+     * relaxed load and store suffice; `pipeline_get_stage_stats` reads it concurrently.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + amount, memory_order_relaxed);
+}
+
+static void pipeline_backoff(int *waits)
+{
+    /**
+     * Waits for a queue to change: yields the CPU for the first
+     * `PIPELINE_YIELDS_BEFORE_SLEEP` calls, then sleeps `PIPELINE_SLEEP_NS` per call so an
+     * idle or blocked stage stops burning a core.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    if ((*waits)++ < PIPELINE_YIELDS_BEFORE_SLEEP)
+    {
+        sched_yield();
+        return;
+    }
+    struct timespec delay = {0, PIPELINE_SLEEP_NS};
+    nanosleep(&delay, NULL);
+}
+
+struct Pipeline *pipeline_create(int queue_capacity, int batch_size)
+{
+    /**
+     * Creates an empty pipeline of stages connected by bounded queues.
+     *
+     * Stages are added with `pipeline_add_stage` and wired with `pipeline_connect`, then
+     * `pipeline_start` launches their threads. Every stage owns a bounded queue of
+     * `queue_capacity` values in front of it; a stage whose consumers fall behind blocks
+     * when their queue is full, so backpressure travels upstream to `pipeline_push`.
+     *
+     * @note The created pipeline must be released with `pipeline_free`.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue_capacity Capacity of each stage's input queue (0 selects
+     *                       `PIPELINE_DEFAULT_QUEUE_CAPACITY`).
+     * @param batch_size Maximum number of values per stage call (0 selects
+     *                   `PIPELINE_DEFAULT_BATCH`).
+     * @return Pointer to the new pipeline, or NULL if allocation fails.
+     */
+    struct Pipeline *pipeline = (struct Pipeline *)calloc(1, sizeof(struct Pipeline));
+    if (!pipeline)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for Pipeline.\n");
+        return NULL;
+    }
+    pipeline->queue_capacity = queue_capacity > 0 ? queue_capacity : PIPELINE_DEFAULT_QUEUE_CAPACITY;
+    pipeline->batch_size = batch_size > 0 ? batch_size : PIPELINE_DEFAULT_BATCH;
+    return pipeline;
+}
+
+int pipeline_add_stage(struct Pipeline *pipeline, const char *name, PipelineStageFn fn, void *context, int threads,
+                       int cpu)
+{
+    /**
+     * Adds a stage that calls `fn(context, values, count, emitter)` for every batch of
+     * values taken from its input queue.
+     *
+     * A stage with several threads runs `fn` concurrently, so `context` must then be safe
+     * to share; per-thread state belongs in the stage's own synchronization. Threads are
+     * pinned to consecutive CPUs of `affinity_topology()` starting at index `cpu`, wrapping
+     * around the CPUs the process may run on.
+     *
+     * @note Stages must be added before `pipeline_start`.
+     *
+     * @complexity Time complexity: O(c), where c is the queue capacity.
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     * @param name Name reported in the stage's stats.
+     * @param fn Stage function.
+     * @param context Argument passed to `fn`.
+     * @param threads Number of threads running the stage (at least 1).
+     * @param cpu Index of the first CPU to pin the threads to, or `PIPELINE_NO_CPU`; other
+     *            negative values are rejected.
+     * @return The stage index, or -1 on error.
+     */
+    if (!pipeline || !fn || pipeline->started)
+    {
+        fprintf(stderr, "ERROR: Cannot add a stage to a NULL or running pipeline.\n");
+        return -1;
+    }
+    if (pipeline->stage_count == PIPELINE_MAX_STAGES)
+    {
+        fprintf(stderr, "ERROR: Maximum number of pipeline stages (%d) reached.\n", PIPELINE_MAX_STAGES);
+        return -1;
+    }
+    if (cpu < 0 && cpu != PIPELINE_NO_CPU)
+    {
+        fprintf(stderr, "ERROR: Invalid CPU %d for pipeline stage; use PIPELINE_NO_CPU to leave it unpinned.\n", cpu);
+        return -1;
+    }
+    struct BoundedQueue *input = bounded_queue_create(pipeline->queue_capacity);
+    if (!input)
+    {
+        return -1;
+    }
+    int index = pipeline->stage_count++;
+    struct PipelineStage *stage = &pipeline->stages[index];
+    stage->name = name ? name : "stage";
+    stage->fn = fn;
+    stage->context = context;
+    stage->thread_count = threads > 0 ? threads : 1;
+    stage->cpu = cpu;
+    stage->input = input;
+    return index;
+}
+
+int pipeline_connect(struct Pipeline *pipeline, int from_stage, int to_stage)
+{
+    /**
+     * Sends the values a stage emits on its next output to another stage's input queue.
+     *
+     * Stages may fan out to several outputs and fan in from several upstream stages.
+     * Edges must point from an earlier stage to a later one, which keeps the graph
+     * acyclic so closing the pipeline always reaches every stage.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     * @param from_stage Index of the emitting stage.
+     * @param to_stage Index of the receiving stage.
+     * @return The output index `from_stage` passes to `pipeline_emit`, or -1 on error.
+     */
+    if (!pipeline || pipeline->started || from_stage < 0 || to_stage >= pipeline->stage_count || from_stage >= to_stage)
+    {
+        fprintf(stderr, "ERROR: Invalid pipeline connection %d -> %d.\n", from_stage, to_stage);
+        return -1;
+    }
+    struct PipelineStage *from = &pipeline->stages[from_stage];
+    if (from->output_count == PIPELINE_MAX_OUTPUTS)
+    {
+        fprintf(stderr, "ERROR: Maximum number of stage outputs (%d) reached.\n", PIPELINE_MAX_OUTPUTS);
+        return -1;
+    }
+    from->outputs[from->output_count] = to_stage;
+    pipeline->stages[to_stage].upstream_count++;
+    return from->output_count++;
+}
+
+static void pipeline_flush(struct PipelineEmitter *emitter, int output)
+{
+    /**
+     * Pushes one output's buffered values to the downstream queue, waiting while it is
+     * full. The wait is the backpressure: this stage stops consuming its own input until
+     * the slower stage catches up.
+     *
+     * @complexity Time complexity: O(k), where k is the number of buffered values, plus
+     *             the wait for room.
+     */
+    struct PipelineWorker *worker = emitter->worker;
+    struct PipelineStage *stage = &worker->pipeline->stages[worker->stage];
+    struct PipelineOutputBuffer *buffer = &emitter->outputs[output];
+    struct BoundedQueue *queue = worker->pipeline->stages[stage->outputs[output]].input;
+    int pushed = 0;
+    int waits = 0;
+    while (pushed < buffer->count)
+    {
+        pushed += bounded_queue_push_bulk(queue, buffer->values + pushed, buffer->count - pushed);
+        if (pushed < buffer->count)
+        {
+            if (waits == 0)
+            {
+                QUEUE_TRACE2(pipeline_stall, worker->stage, stage->outputs[output]);
+            }
+            pipeline_count(&worker->full_stalls, 1);
+            pipeline_backoff(&waits);
+        }
+    }
+    pipeline_count(&worker->emitted, (uint64_t)buffer->count);
+    buffer->count = 0;
+}
+
+void pipeline_emit(struct PipelineEmitter *emitter, int output, int value)
+{
+    /**
+     * Sends a value to one of the stage's outputs.
+     *
+     * Values are buffered per output and pushed to the downstream queue a batch at a
+     * time: when `batch_size` values are buffered and after every call of the stage
+     * function, so batching flows from stage to stage.
+     *
+     * @complexity Time complexity: O(1) amortized.
+     *
+     * @param emitter The emitter passed to the stage function.
+     * @param output Output index returned by `pipeline_connect`.
+     * @param value The value to send.
+     */
+    if (!emitter)
+    {
+        return;
+    }
+    struct PipelineStage *stage = &emitter->worker->pipeline->stages[emitter->worker->stage];
+    if (output < 0 || output >= stage->output_count)
+    {
+        fprintf(stderr, "ERROR: Stage %s has no output %d.\n", stage->name, output);
+        return;
+    }
+    struct PipelineOutputBuffer *buffer = &emitter->outputs[output];
+    buffer->values[buffer->count++] = value;
+    if (buffer->count == emitter->worker->pipeline->batch_size)
+    {
+        pipeline_flush(emitter, output);
+    }
+}
+
+static void pipeline_pin(int cpu)
+{
+    /**
+     * Pins the calling stage thread to entry `cpu` of `affinity_topology()`, wrapping
+     * around the CPUs the process may run on.
+     *
+     * @note `cpu` is non-negative: `pipeline_add_stage` rejects other negative values
+     *       than `PIPELINE_NO_CPU`, which never reaches this function.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    const struct CpuTopology *topology = affinity_topology();
+    int count = topology->cpu_count > 0 ? topology->cpu_count : 1;
+    affinity_pin_thread(topology->cpus[((cpu % count) + count) % count].cpu);
+}
+
+static void pipeline_stage_thread_done(struct Pipeline *pipeline, struct PipelineStage *stage)
+{
+    /**
+     * Records that one thread of `stage` has finished. The last one stamps the stage's
+     * end time and closes its contribution to every output stage.
+     *
+     * @complexity Time complexity: O(o), where o is the number of outputs of the stage.
+     */
+    if (atomic_fetch_sub(&stage->threads_running, 1) == 1)
+    {
+        atomic_store_explicit(&stage->end_ns, queue_clock_ns(CLOCK_MONOTONIC), memory_order_relaxed);
+        for (int output = 0; output < stage->output_count; output++)
+        {
+            atomic_fetch_sub(&pipeline->stages[stage->outputs[output]].producers_open, 1);
+        }
+    }
+}
+
+static void *pipeline_worker_run(void *arg)
+{
+    /**
+     * Stage thread: takes batches from the stage's input queue, runs the stage function
+     * and pushes what it emitted downstream.
+     *
+     * The input is finished when every upstream stage (or, for a source stage,
+     * `pipeline_close`) has stopped producing and the queue is empty. The last thread of
+     * a stage to finish closes the stage's own contribution to its outputs.
+     *
+     * @complexity Time complexity: O(n) for the n values the thread consumes.
+     */
+    struct PipelineWorker *worker = (struct PipelineWorker *)arg;
+    struct Pipeline *pipeline = worker->pipeline;
+    struct PipelineStage *stage = &pipeline->stages[worker->stage];
+    int *values = (int *)malloc((size_t)pipeline->batch_size * sizeof(int));
+    if (!values)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for pipeline batch. Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+    if (worker->cpu != PIPELINE_NO_CPU)
+    {
+        pipeline_pin(worker->cpu);
+    }
+
+    int waits = 0;
+    for (;;)
+    {
+        int count = bounded_queue_pop_bulk(stage->input, values, pipeline->batch_size);
+        if (count == 0)
+        {
+            if (atomic_load(&stage->producers_open) == 0)
+            {
+                // Upstream pushes happen before its close, so one more pop sees all of them
+                count = bounded_queue_pop_bulk(stage->input, values, pipeline->batch_size);
+                if (count == 0)
+                {
+                    break;
+                }
+            }
+            else
+            {
+                pipeline_count(&worker->empty_polls, 1);
+                pipeline_backoff(&waits);
+                continue;
+            }
+        }
+        waits = 0;
+        uint64_t start = queue_clock_ns(CLOCK_MONOTONIC);
+        stage->fn(stage->context, values, count, &worker->emitter);
+        for (int output = 0; output < stage->output_count; output++)
+        {
+            if (worker->emitter.outputs[output].count > 0)
+            {
+                pipeline_flush(&worker->emitter, output);
+            }
+        }
+        pipeline_count(&worker->busy_ns, queue_clock_ns(CLOCK_MONOTONIC) - start);
+        pipeline_count(&worker->consumed, (uint64_t)count);
+        pipeline_count(&worker->batches, 1);
+    }
+    free(values);
+    pipeline_stage_thread_done(pipeline, stage);
+    return NULL;
+}
+
+static void pipeline_abort_start(struct Pipeline *pipeline, int failed_stage, int failed_thread)
+{
+    /**
+     * Undoes a partial `pipeline_start`: threads from `failed_thread` of `failed_stage`
+     * onward never ran, so their exit bookkeeping is done here. Closing the sources then
+     * lets every started thread find its (empty) input finished, and they are joined.
+     *
+     * @complexity Time complexity: O(t), where t is the total number of stage threads.
+     */
+    for (int s = failed_stage; s < pipeline->stage_count; s++)
+    {
+        struct PipelineStage *stage = &pipeline->stages[s];
+        for (int t = s == failed_stage ? failed_thread : 0; t < stage->thread_count; t++)
+        {
+            pipeline_stage_thread_done(pipeline, stage);
+        }
+    }
+    pipeline_close(pipeline);
+    for (int s = 0; s <= failed_stage; s++)
+    {
+        int started = s == failed_stage ? failed_thread : pipeline->stages[s].thread_count;
+        for (int t = 0; t < started; t++)
+        {
+            pthread_join(pipeline->stages[s].workers[t].thread, NULL);
+        }
+    }
+    pipeline->joined = true;
+}
+
+bool pipeline_start(struct Pipeline *pipeline)
+{
+    /**
+     * Launches the threads of every stage.
+     *
+     * Stages without an upstream stage are sources: they are fed with `pipeline_push`
+     * until `pipeline_close`.
+     *
+     * If a thread cannot be created, the threads already started are stopped and joined
+     * and the pipeline is left closed; it can only be freed.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(t), where t is the total number of stage threads.
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     * @return `true` if every thread started, `false` otherwise.
+     */
+    if (!pipeline || pipeline->started || pipeline->stage_count == 0)
+    {
+        fprintf(stderr, "ERROR: Cannot start a NULL, running or empty pipeline.\n");
+        return false;
+    }
+    for (int s = 0; s < pipeline->stage_count; s++)
+    {
+        struct PipelineStage *stage = &pipeline->stages[s];
+        atomic_init(&stage->producers_open, stage->upstream_count > 0 ? stage->upstream_count : 1);
+        atomic_init(&stage->threads_running, stage->thread_count);
+        atomic_init(&stage->end_ns, 0);
+        stage->workers = (struct PipelineWorker *)aligned_alloc(
+            PIPELINE_CACHE_LINE, (size_t)stage->thread_count * sizeof(struct PipelineWorker));
+        if (!stage->workers)
+        {
+            fprintf(stderr, "ERROR: Memory allocation failed for pipeline stage %s. Exiting...\n", stage->name);
+            exit(EXIT_FAILURE);
+        }
+        for (int t = 0; t < stage->thread_count; t++)
+        {
+            struct PipelineWorker *worker = &stage->workers[t];
+            *worker = (struct PipelineWorker){.pipeline = pipeline, .stage = s};
+            worker->cpu = stage->cpu == PIPELINE_NO_CPU ? PIPELINE_NO_CPU : stage->cpu + t;
+            worker->emitter.worker = worker;
+            for (int output = 0; output < stage->output_count; output++)
+            {
+                worker->emitter.outputs[output].values = (int *)malloc((size_t)pipeline->batch_size * sizeof(int));
+                if (!worker->emitter.outputs[output].values)
+                {
+                    fprintf(stderr, "ERROR: Memory allocation failed for pipeline output. Exiting...\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+        }
+    }
+    pipeline->start_ns = queue_clock_ns(CLOCK_MONOTONIC);
+    pipeline->started = true;
+    for (int s = 0; s < pipeline->stage_count; s++)
+    {
+        struct PipelineStage *stage = &pipeline->stages[s];
+        for (int t = 0; t < stage->thread_count; t++)
+        {
+            if (pthread_create(&stage->workers[t].thread, NULL, pipeline_worker_run, &stage->workers[t]) != 0)
+            {
+                fprintf(stderr, "ERROR: Failed to start thread %d of pipeline stage %s.\n", t, stage->name);
+                pipeline_abort_start(pipeline, s, t);
+                return false;
+            }
+        }
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Pipeline started with %d stages.\n", pipeline->stage_count);
+#endif
+    return true;
+}
+
+bool pipeline_push_bulk(struct Pipeline *pipeline, int stage, const int *values, int count)
+{
+    /**
+     * Feeds values into a source stage, waiting while its input queue is full.
+     *
+     * @note Safe to call from several threads at once; their values may interleave.
+     *
+     * @complexity Time complexity: O(k), where k is the number of values, plus the wait
+     *             for room.
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     * @param stage Index of a stage without upstream stages.
+     * @param values Array of values to send.
+     * @param count Number of values in the array.
+     * @return `true` if the values were queued, `false` if the stage is not a source or
+     *         the pipeline is not running.
+     */
+    if (!pipeline || !pipeline->started || pipeline->closed || stage < 0 || stage >= pipeline->stage_count ||
+        pipeline->stages[stage].upstream_count > 0)
+    {
+        fprintf(stderr, "ERROR: Pipeline input must go to a source stage of a running pipeline.\n");
+        return false;
+    }
+    struct BoundedQueue *queue = pipeline->stages[stage].input;
+    int pushed = 0;
+    int waits = 0;
+    while (pushed < count)
+    {
+        pushed += bounded_queue_push_bulk(queue, values + pushed, count - pushed);
+        if (pushed < count)
+        {
+            pipeline_backoff(&waits);
+        }
+    }
+    return true;
+}
+
+bool pipeline_push(struct Pipeline *pipeline, int stage, int value)
+{
+    /**
+     * Feeds one value into a source stage, waiting while its input queue is full.
+     *
+     * @complexity Time complexity: O(1), plus the wait for room.
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     * @param stage Index of a stage without upstream stages.
+     * @param value The value to send.
+     * @return `true` if the value was queued, `false` otherwise.
+     */
+    return pipeline_push_bulk(pipeline, stage, &value, 1);
+}
+
+void pipeline_close(struct Pipeline *pipeline)
+{
+    /**
+     * Ends the input of the source stages.
+     *
+     * Each stage finishes the values already queued and then closes its outputs, so the
+     * pipeline drains from the sources to the sinks. Use `pipeline_wait` to wait for it.
+     *
+     * @note Pushes must have returned before the pipeline is closed.
+     *
+     * @complexity Time complexity: O(s), where s is the number of stages.
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     */
+    if (!pipeline || !pipeline->started || pipeline->closed)
+    {
+        return;
+    }
+    pipeline->closed = true;
+    for (int s = 0; s < pipeline->stage_count; s++)
+    {
+        if (pipeline->stages[s].upstream_count == 0)
+        {
+            atomic_fetch_sub(&pipeline->stages[s].producers_open, 1);
+        }
+    }
+}
+
+void pipeline_wait(struct Pipeline *pipeline)
+{
+    /**
+     * Waits until every stage has drained its input and its threads have exited.
+     *
+     * @note Returns only after `pipeline_close`, which may be called from another thread.
+     *
+     * @complexity Time complexity: O(t), where t is the total number of stage threads,
+     *             plus the time to drain the pipeline.
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     */
+    if (!pipeline || !pipeline->started || pipeline->joined)
+    {
+        return;
+    }
+    for (int s = 0; s < pipeline->stage_count; s++)
+    {
+        for (int t = 0; t < pipeline->stages[s].thread_count; t++)
+        {
+            pthread_join(pipeline->stages[s].workers[t].thread, NULL);
+        }
+    }
+    pipeline->joined = true;
+}
+
+int pipeline_stage_count(struct Pipeline *pipeline)
+{
+    /**
+     * Returns the number of stages in the pipeline.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     * @return The number of stages, or 0 if the pipeline pointer is NULL.
+     */
+    return pipeline ? pipeline->stage_count : 0;
+}
+
+bool pipeline_get_stage_stats(struct Pipeline *pipeline, int stage, struct PipelineStageStats *out)
+{
+    /**
+     * Reads the counters of one stage, summed over its threads, and the current depth of
+     * its input queue.
+     *
+     * `consumed` values went through `batches` calls of the stage function and `emitted`
+     * values went downstream. `busy_ns` is the time spent in the stage function plus
+     * pushing its output, including `full_stalls` waits for room in a full downstream
+     * queue; `empty_polls` counts the times the stage found its input empty. `throughput`
+     * is consumed values per second since the start, up to the moment the stage finished.
+     * May be called while the pipeline runs.
+     *
+     * @complexity Time complexity: O(t), where t is the number of threads of the stage.
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     * @param stage Index of the stage.
+     * @param out Pointer to the structure that receives the stats.
+     * @return `true` if the stats were read, `false` if the stage does not exist.
+     */
+    if (!pipeline || !out || stage < 0 || stage >= pipeline->stage_count)
+    {
+        return false;
+    }
+    struct PipelineStage *pipeline_stage = &pipeline->stages[stage];
+    *out = (struct PipelineStageStats){0};
+    out->name = pipeline_stage->name;
+    out->threads = pipeline_stage->thread_count;
+    out->queue_depth = bounded_queue_size(pipeline_stage->input);
+    out->queue_capacity = bounded_queue_capacity(pipeline_stage->input);
+    if (!pipeline->started)
+    {
+        return true;
+    }
+    for (int t = 0; t < pipeline_stage->thread_count; t++)
+    {
+        struct PipelineWorker *worker = &pipeline_stage->workers[t];
+        out->consumed += atomic_load_explicit(&worker->consumed, memory_order_relaxed);
+        out->emitted += atomic_load_explicit(&worker->emitted, memory_order_relaxed);
+        out->batches += atomic_load_explicit(&worker->batches, memory_order_relaxed);
+        out->full_stalls += atomic_load_explicit(&worker->full_stalls, memory_order_relaxed);
+        out->empty_polls += atomic_load_explicit(&worker->empty_polls, memory_order_relaxed);
+        out->busy_ns += atomic_load_explicit(&worker->busy_ns, memory_order_relaxed);
+    }
+    uint64_t end_ns = atomic_load_explicit(&pipeline_stage->end_ns, memory_order_relaxed);
+    out->elapsed_ns = (end_ns ? end_ns : queue_clock_ns(CLOCK_MONOTONIC)) - pipeline->start_ns;
+    out->throughput = out->elapsed_ns ? (double)out->consumed * 1e9 / (double)out->elapsed_ns : 0.0;
+    return true;
+}
+
+void pipeline_free(struct Pipeline *pipeline)
+{
+    /**
+     * Closes the pipeline if needed, waits for its stages to drain and frees it.
+     *
+     * @complexity Time complexity: O(t + s), where t is the number of stage threads and s
+     *             the number of stages, plus the time to drain the pipeline.
+     *
+     * @param pipeline Pointer to the Pipeline structure.
+     */
+    if (!pipeline)
+    {
+        fprintf(stderr, "INFO: Pipeline is already NULL. Skipping free.\n");
+        return;
+    }
+    pipeline_close(pipeline);
+    pipeline_wait(pipeline);
+    for (int s = 0; s < pipeline->stage_count; s++)
+    {
+        struct PipelineStage *stage = &pipeline->stages[s];
+        if (stage->workers)
+        {
+            for (int t = 0; t < stage->thread_count; t++)
+            {
+                for (int output = 0; output < stage->output_count; output++)
+                {
+                    free(stage->workers[t].emitter.outputs[output].values);
+                }
+            }
+            free(stage->workers);
+        }
+        bounded_queue_free(stage->input);
+    }
+    free(pipeline);
+}
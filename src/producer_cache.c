@@ -0,0 +1,245 @@
+#define _POSIX_C_SOURCE 200809L
+#include "producer_cache.h"
+#include "queue_clock.h"
+
+struct ProducerCache
+{
+    struct MSQueue *queue;
+    int capacity;
+    int count;
+    uint64_t max_delay_ns;
+    uint64_t first_push_ns;
+    struct BatchController controller;
+    struct ProducerCacheStats stats;
+    int values[];
+};
+
+struct ProducerCache *producer_cache_create(struct MSQueue *queue, int capacity, uint64_t max_delay_ns)
+{
+    /**
+     * Creates a producer handle that buffers pushes to the shared lock-free queue.
+     *
+     * Pushes go into a small private array and are published with `ms_queue_push_bulk`,
+     * so the shared queue sees one CAS per batch instead of one per element. A batch is
+     * published when the array is full, on `producer_cache_flush`, or once its oldest
+     * value has waited `max_delay_ns`, which bounds the latency the buffering adds.
+     *
+     * @note A handle belongs to a single producer thread; create one per thread.
+     * @note The created handle must be released with `producer_cache_free`, which publishes
+     *       any buffered values.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Shared queue the batches are published to.
+     * @param capacity Maximum batch size (0 selects `PRODUCER_CACHE_DEFAULT_CAPACITY`).
+     * @param max_delay_ns Longest time a value may stay buffered; 0 disables the time bound.
+     * @return Pointer to the newly created `ProducerCache`, or NULL if creation fails.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Cannot create a producer cache for a NULL QUEUE.\n");
+        return NULL;
+    }
+    if (capacity <= 0)
+    {
+        capacity = PRODUCER_CACHE_DEFAULT_CAPACITY;
+    }
+    struct ProducerCache *cache = (struct ProducerCache *)malloc(sizeof(struct ProducerCache) + (size_t)capacity * sizeof(int));
+    if (!cache)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for ProducerCache.\n");
+        return NULL;
+    }
+    cache->queue = queue;
+    cache->capacity = capacity;
+    cache->count = 0;
+    cache->max_delay_ns = max_delay_ns;
+    cache->first_push_ns = 0;
+    cache->stats = (struct ProducerCacheStats){0};
+    batch_controller_init(&cache->controller, 1, capacity, 0);
+    return cache;
+}
+
+void producer_cache_set_target_latency(struct ProducerCache *cache, uint64_t target_latency_ns)
+{
+    /**
+     * Lets a batch controller choose the batch size, targeting `target_latency_ns`.
+     *
+     * Instead of always filling `capacity` values, batches are published once they reach
+     * the controller's size. Batches that fill up grow the size while the oldest value
+     * waited well under the target; batches published by the time bound or an explicit
+     * flush before reaching half of it shrink the size toward 1, and batches that took
+     * longer than the target halve it. The decisions are reported in the `batching`
+     * counters of `producer_cache_get_stats`. The target also bounds buffering like
+     * `max_delay_ns` when it is the tighter of the two.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param cache Pointer to the ProducerCache structure.
+     * @param target_latency_ns Latency SLO for a buffered value; 0 restores fixed batches.
+     */
+    if (!cache)
+    {
+        return;
+    }
+    batch_controller_init(&cache->controller, 1, cache->capacity, target_latency_ns);
+}
+
+static uint64_t producer_cache_deadline(const struct ProducerCache *cache)
+{
+    /**
+     * Returns how long the oldest buffered value may wait: the tighter of `max_delay_ns`
+     * and the latency target, or 0 when neither is set.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    uint64_t target = cache->controller.target_latency_ns;
+    if (cache->max_delay_ns == 0 || (target && target < cache->max_delay_ns))
+    {
+        return target;
+    }
+    return cache->max_delay_ns;
+}
+
+static void producer_cache_publish(struct ProducerCache *cache, uint64_t now)
+{
+    /**
+     * Publishes the buffered values to the shared queue as one batch and reports it to
+     * the batch controller.
+     *
+     * For a producer, the backlog is the number of values the batch collected: reaching
+     * the batch size means the producer outpaces it.
+     *
+     * @complexity Time complexity: O(k), where k is the number of buffered values.
+     */
+    if (cache->controller.target_latency_ns)
+    {
+        now = now ? now : queue_clock_ns(CLOCK_MONOTONIC);
+        batch_controller_update(&cache->controller, (size_t)cache->count, now - cache->first_push_ns);
+    }
+    ms_queue_push_bulk(cache->queue, cache->values, cache->count);
+    cache->count = 0;
+    cache->stats.flushes++;
+}
+
+void producer_cache_push(struct ProducerCache *cache, int data)
+{
+    /**
+     * Buffers the given data and publishes the batch if it is full or has waited too long.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails while
+     *       publishing.
+     *
+     * @complexity Time complexity: O(1) amortized.
+     *
+     * @param cache Pointer to the ProducerCache structure.
+     * @param data The value to store.
+     */
+    if (!cache)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL producer cache.\n");
+        return;
+    }
+    uint64_t deadline = producer_cache_deadline(cache);
+    uint64_t now = deadline ? queue_clock_ns(CLOCK_MONOTONIC) : 0;
+    if (cache->count == 0)
+    {
+        cache->first_push_ns = now;
+    }
+    cache->values[cache->count++] = data;
+    cache->stats.pushes++;
+
+    if (cache->count >= batch_controller_size(&cache->controller))
+    {
+        cache->stats.full_flushes++;
+        producer_cache_publish(cache, now);
+    }
+    else if (deadline && now - cache->first_push_ns >= deadline)
+    {
+        cache->stats.timed_flushes++;
+        producer_cache_publish(cache, now);
+    }
+}
+
+void producer_cache_flush(struct ProducerCache *cache)
+{
+    /**
+     * Publishes every buffered value now.
+     *
+     * @complexity Time complexity: O(k), where k is the number of buffered values.
+     *
+     * @param cache Pointer to the ProducerCache structure.
+     */
+    if (!cache || cache->count == 0)
+    {
+        return;
+    }
+    cache->stats.explicit_flushes++;
+    producer_cache_publish(cache, 0);
+}
+
+bool producer_cache_poll(struct ProducerCache *cache)
+{
+    /**
+     * Publishes the buffered values if the oldest one has waited `max_delay_ns` (or the
+     * latency target, if it is tighter).
+     *
+     * Pushes check the time bound themselves; a producer that may go idle with values
+     * buffered calls this from its idle loop so they are still published in time.
+     *
+     * @complexity Time complexity: O(1), or O(k) when the batch is published.
+     *
+     * @param cache Pointer to the ProducerCache structure.
+     * @return `true` if a batch was published, `false` otherwise.
+     */
+    if (!cache || cache->count == 0 || !producer_cache_deadline(cache))
+    {
+        return false;
+    }
+    uint64_t now = queue_clock_ns(CLOCK_MONOTONIC);
+    if (now - cache->first_push_ns < producer_cache_deadline(cache))
+    {
+        return false;
+    }
+    cache->stats.timed_flushes++;
+    producer_cache_publish(cache, now);
+    return true;
+}
+
+void producer_cache_get_stats(struct ProducerCache *cache, struct ProducerCacheStats *out)
+{
+    /**
+     * Copies the handle's counters into `out`.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param cache Pointer to the ProducerCache structure.
+     * @param out Pointer to the structure that receives the counters.
+     */
+    if (!cache || !out)
+    {
+        return;
+    }
+    *out = cache->stats;
+    batch_controller_get_stats(&cache->controller, &out->batching);
+}
+
+void producer_cache_free(struct ProducerCache *cache)
+{
+    /**
+     * Publishes any buffered values and frees the producer handle.
+     *
+     * @note The shared queue is not freed.
+     *
+     * @complexity Time complexity: O(k), where k is the number of buffered values.
+     *
+     * @param cache Pointer to the ProducerCache structure.
+     */
+    if (!cache)
+    {
+        fprintf(stderr, "INFO: Producer cache is already NULL. Skipping free.\n");
+        return;
+    }
+    producer_cache_flush(cache);
+    free(cache);
+}
@@ -0,0 +1,386 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <pthread.h>
+#include "queue_metrics.h"
+#include "queue_clock.h"
+
+// Per-queue ring of samples plus the totals of the previous sample, used for the rates
+struct QueueMetricsRing
+{
+    struct QueueMetricsSample *samples;
+    int head;
+    int count;
+    uint64_t last_ns;
+};
+
+static pthread_mutex_t metrics_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t metrics_wakeup;
+static pthread_t metrics_thread;
+static bool metrics_running = false;
+static bool metrics_stopping = false;
+static bool metrics_atexit_registered = false;
+static uint64_t metrics_interval_ns = QUEUE_METRICS_DEFAULT_INTERVAL_NS;
+static int metrics_capacity = QUEUE_METRICS_DEFAULT_CAPACITY;
+static struct QueueMetricsRing metrics_rings[MAX_QUEUES];
+
+static const struct QueueMetricsSample *metrics_latest(const struct QueueMetricsRing *ring)
+{
+    /**
+     * Returns the newest sample of a ring, or NULL if it holds none.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    if (ring->count == 0)
+    {
+        return NULL;
+    }
+    return &ring->samples[(ring->head + ring->count - 1) % metrics_capacity];
+}
+
+static void metrics_record(struct QueueMetricsRing *ring, uint64_t pushed, uint64_t popped, uint64_t now_ns,
+                           uint64_t timestamp_ms)
+{
+    /**
+     * Appends one sample to a ring, overwriting the oldest one once the ring is full.
+     *
+     * Rates are the counter deltas since the previous sample of the same queue divided by
+     * the elapsed monotonic time; the first sample of a queue reports rates of 0.
+     *
+     * @note Called with `metrics_lock` held.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    if (!ring->samples)
+    {
+        ring->samples = (struct QueueMetricsSample *)malloc((size_t)metrics_capacity * sizeof(struct QueueMetricsSample));
+        if (!ring->samples)
+        {
+            fprintf(stderr, "ERROR: Memory allocation failed for the QUEUE metrics ring.\n");
+            return;
+        }
+    }
+    struct QueueMetricsSample sample = {.timestamp_ms = timestamp_ms, .pushed = pushed, .popped = popped};
+    sample.depth = pushed >= popped ? pushed - popped : 0;
+    const struct QueueMetricsSample *previous = metrics_latest(ring);
+    if (previous && now_ns > ring->last_ns)
+    {
+        double seconds = (double)(now_ns - ring->last_ns) / 1e9;
+        sample.push_rate = (double)(pushed - previous->pushed) / seconds;
+        sample.pop_rate = (double)(popped - previous->popped) / seconds;
+    }
+    ring->last_ns = now_ns;
+
+    if (ring->count < metrics_capacity)
+    {
+        ring->samples[(ring->head + ring->count) % metrics_capacity] = sample;
+        ring->count++;
+    }
+    else
+    {
+        ring->samples[ring->head] = sample;
+        ring->head = (ring->head + 1) % metrics_capacity;
+    }
+}
+
+void queue_metrics_sample(void)
+{
+    /**
+     * Records one sample of every registered queue now.
+     *
+     * The background sampler calls this once per interval; it can also be called directly
+     * to sample at chosen points without a thread. Queues are read through a snapshot of
+     * the registry (`queue_registry`) and their `pushed`/`popped` counters, which the
+     * owners update with relaxed atomic stores. No queue is locked and no node is touched,
+     * so sampling never delays a producer or a consumer. The depth is `pushed - popped`.
+     *
+     * @complexity Time complexity: O(q), where q is the number of registered queues.
+     */
+    struct LinkedList *lists[MAX_QUEUES];
+    int count = queue_registry(lists, MAX_QUEUES);
+    uint64_t now_ns = queue_clock_ns(CLOCK_MONOTONIC);
+    uint64_t timestamp_ms = queue_clock_ns(CLOCK_REALTIME) / 1000000ULL;
+
+    pthread_mutex_lock(&metrics_lock);
+    for (int i = 0; i < count; i++)
+    {
+        uint64_t popped = __atomic_load_n(&lists[i]->popped, __ATOMIC_RELAXED);
+        uint64_t pushed = __atomic_load_n(&lists[i]->pushed, __ATOMIC_RELAXED);
+        metrics_record(&metrics_rings[lists[i]->index], pushed, popped, now_ns, timestamp_ms);
+    }
+    pthread_mutex_unlock(&metrics_lock);
+}
+
+static void *metrics_run(void *arg)
+{
+    /**
+     * Body of the sampler thread: samples every `metrics_interval_ns` until stopped.
+     *
+     * @complexity Time complexity: O(q) per interval.
+     */
+    (void)arg;
+    uint64_t deadline = queue_clock_ns(CLOCK_MONOTONIC);
+    pthread_mutex_lock(&metrics_lock);
+    while (!metrics_stopping)
+    {
+        pthread_mutex_unlock(&metrics_lock);
+        queue_metrics_sample();
+        pthread_mutex_lock(&metrics_lock);
+
+        deadline += metrics_interval_ns;
+        struct timespec until = {(time_t)(deadline / 1000000000ULL), (long)(deadline % 1000000000ULL)};
+        while (!metrics_stopping && pthread_cond_timedwait(&metrics_wakeup, &metrics_lock, &until) != ETIMEDOUT)
+        {
+        }
+    }
+    pthread_mutex_unlock(&metrics_lock);
+    return NULL;
+}
+
+bool queue_metrics_start(uint64_t interval_ns, int capacity)
+{
+    /**
+     * Starts the background thread that samples the depth, push rate and pop rate of every
+     * registered queue.
+     *
+     * Each queue gets a ring of the `capacity` most recent samples, allocated when the
+     * queue is first seen. The sampler runs at a fixed rate, so the history covers
+     * `capacity * interval_ns`. It is stopped with `queue_metrics_stop`, which is also
+     * registered with `atexit`. The automatic cleanup of `queue_enable_auto_cleanup` stops
+     * the sampler itself before freeing the queues, so the two may be enabled in any order.
+     *
+     * @note Samples recorded before the call are discarded.
+     *
+     * @complexity Time complexity: O(MAX_QUEUES).
+     *
+     * @param interval_ns Sampling interval (0 selects `QUEUE_METRICS_DEFAULT_INTERVAL_NS`).
+     * @param capacity Samples kept per queue (0 selects `QUEUE_METRICS_DEFAULT_CAPACITY`).
+     * @return `true` if the sampler was started, `false` if it is already running or the
+     *         thread cannot be created.
+     */
+    if (interval_ns == 0)
+    {
+        interval_ns = QUEUE_METRICS_DEFAULT_INTERVAL_NS;
+    }
+    if (capacity <= 0)
+    {
+        capacity = QUEUE_METRICS_DEFAULT_CAPACITY;
+    }
+
+    pthread_mutex_lock(&metrics_lock);
+    if (metrics_running)
+    {
+        pthread_mutex_unlock(&metrics_lock);
+        fprintf(stderr, "ERROR: QUEUE metrics sampler is already running.\n");
+        return false;
+    }
+    for (int i = 0; i < MAX_QUEUES; i++)
+    {
+        free(metrics_rings[i].samples);
+        metrics_rings[i] = (struct QueueMetricsRing){0};
+    }
+    metrics_interval_ns = interval_ns;
+    metrics_capacity = capacity;
+    metrics_stopping = false;
+
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&metrics_wakeup, &attributes);
+    pthread_condattr_destroy(&attributes);
+    if (pthread_create(&metrics_thread, NULL, metrics_run, NULL) != 0)
+    {
+        pthread_cond_destroy(&metrics_wakeup);
+        pthread_mutex_unlock(&metrics_lock);
+        fprintf(stderr, "ERROR: Cannot create the QUEUE metrics sampler thread.\n");
+        return false;
+    }
+    metrics_running = true;
+    if (!metrics_atexit_registered)
+    {
+        metrics_atexit_registered = true;
+        atexit(queue_metrics_stop);
+    }
+    pthread_mutex_unlock(&metrics_lock);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: QUEUE metrics sampler started, one sample every %llu ns.\n", (unsigned long long)interval_ns);
+#endif
+    return true;
+}
+
+void queue_metrics_stop(void)
+{
+    /**
+     * Stops the background sampler and waits for its thread to exit.
+     *
+     * The recorded samples stay available to `queue_metrics_read` and `queue_metrics_dump`.
+     * Calling it when the sampler is not running has no effect.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    pthread_mutex_lock(&metrics_lock);
+    if (!metrics_running)
+    {
+        pthread_mutex_unlock(&metrics_lock);
+        return;
+    }
+    metrics_stopping = true;
+    pthread_cond_signal(&metrics_wakeup);
+    pthread_mutex_unlock(&metrics_lock);
+
+    pthread_join(metrics_thread, NULL);
+    pthread_mutex_lock(&metrics_lock);
+    metrics_running = false;
+    pthread_cond_destroy(&metrics_wakeup);
+    pthread_mutex_unlock(&metrics_lock);
+}
+
+int queue_metrics_read(int index, struct QueueMetricsSample *out_samples, int max_samples)
+{
+    /**
+     * Copies the most recent samples of the queue with the given index, oldest first.
+     *
+     * @complexity Time complexity: O(k), where k is the number of copied samples.
+     *
+     * @param index Index of the queue (`list->index`).
+     * @param out_samples Array that receives the samples.
+     * @param max_samples Capacity of `out_samples`.
+     * @return The number of samples copied, 0 if the queue has not been sampled.
+     */
+    if (index < 0 || index >= MAX_QUEUES || !out_samples || max_samples <= 0)
+    {
+        return 0;
+    }
+    pthread_mutex_lock(&metrics_lock);
+    const struct QueueMetricsRing *ring = &metrics_rings[index];
+    int count = ring->count < max_samples ? ring->count : max_samples;
+    int first = ring->head + ring->count - count;
+    for (int i = 0; i < count; i++)
+    {
+        out_samples[i] = ring->samples[(first + i) % metrics_capacity];
+    }
+    pthread_mutex_unlock(&metrics_lock);
+    return count;
+}
+
+static void metrics_dump_prometheus(FILE *out)
+{
+    /**
+     * Writes the newest sample of every queue in the Prometheus text exposition format.
+     *
+     * A scrape only needs the current values; the history stays in the rings and is
+     * exported by the JSON format.
+     *
+     * @note Called with `metrics_lock` held.
+     *
+     * @complexity Time complexity: O(MAX_QUEUES).
+     */
+    static const char *const names[] = {"queue_depth", "queue_pushed_total", "queue_popped_total",
+                                        "queue_push_rate", "queue_pop_rate"};
+    static const char *const help[] = {"Elements in the queue.", "Elements pushed since creation.",
+                                       "Elements popped or freed since creation.",
+                                       "Pushes per second over the last sampling interval.",
+                                       "Pops per second over the last sampling interval."};
+    for (int metric = 0; metric < 5; metric++)
+    {
+        fprintf(out, "# HELP %s %s\n# TYPE %s %s\n", names[metric], help[metric], names[metric],
+                metric == 1 || metric == 2 ? "counter" : "gauge");
+        for (int i = 0; i < MAX_QUEUES; i++)
+        {
+            const struct QueueMetricsSample *sample = metrics_latest(&metrics_rings[i]);
+            if (!sample)
+            {
+                continue;
+            }
+            fprintf(out, "%s{queue=\"%d\"} ", names[metric], i);
+            switch (metric)
+            {
+            case 0:
+                fprintf(out, "%llu", (unsigned long long)sample->depth);
+                break;
+            case 1:
+                fprintf(out, "%llu", (unsigned long long)sample->pushed);
+                break;
+            case 2:
+                fprintf(out, "%llu", (unsigned long long)sample->popped);
+                break;
+            case 3:
+                fprintf(out, "%.3f", sample->push_rate);
+                break;
+            default:
+                fprintf(out, "%.3f", sample->pop_rate);
+                break;
+            }
+            fprintf(out, " %llu\n", (unsigned long long)sample->timestamp_ms);
+        }
+    }
+}
+
+static void metrics_dump_json(FILE *out)
+{
+    /**
+     * Writes the full sample history of every queue as one JSON object.
+     *
+     * @note Called with `metrics_lock` held.
+     *
+     * @complexity Time complexity: O(q * c), where q is the number of sampled queues and c
+     *             the ring capacity.
+     */
+    fprintf(out, "{\"interval_ns\":%llu,\"queues\":[", (unsigned long long)metrics_interval_ns);
+    bool first_queue = true;
+    for (int i = 0; i < MAX_QUEUES; i++)
+    {
+        const struct QueueMetricsRing *ring = &metrics_rings[i];
+        if (ring->count == 0)
+        {
+            continue;
+        }
+        fprintf(out, "%s{\"queue\":%d,\"samples\":[", first_queue ? "" : ",", i);
+        first_queue = false;
+        for (int s = 0; s < ring->count; s++)
+        {
+            const struct QueueMetricsSample *sample = &ring->samples[(ring->head + s) % metrics_capacity];
+            fprintf(out, "%s{\"timestamp_ms\":%llu,\"depth\":%llu,\"pushed\":%llu,\"popped\":%llu,"
+                         "\"push_rate\":%.3f,\"pop_rate\":%.3f}",
+                    s ? "," : "", (unsigned long long)sample->timestamp_ms, (unsigned long long)sample->depth,
+                    (unsigned long long)sample->pushed, (unsigned long long)sample->popped, sample->push_rate,
+                    sample->pop_rate);
+        }
+        fprintf(out, "]}");
+    }
+    fprintf(out, "]}\n");
+}
+
+int queue_metrics_dump(FILE *out, enum QueueMetricsFormat format)
+{
+    /**
+     * Exports the recorded samples in the Prometheus text format or as JSON.
+     *
+     * `QUEUE_METRICS_PROMETHEUS` writes the latest depth, totals and rates of each queue,
+     * labelled `queue="<index>"`, for a scrape endpoint or the node exporter's textfile
+     * collector. `QUEUE_METRICS_JSON` writes every sample in the rings, oldest first, for
+     * capacity planning over time. Use `open_memstream` to dump into a string.
+     *
+     * @complexity Time complexity: O(q * c), where q is the number of sampled queues and c
+     *             the ring capacity.
+     *
+     * @param out Stream to write to.
+     * @param format `QUEUE_METRICS_PROMETHEUS` or `QUEUE_METRICS_JSON`.
+     * @return 0 on success, -1 if the stream reports a write error.
+     */
+    if (!out)
+    {
+        fprintf(stderr, "ERROR: Cannot dump QUEUE metrics to a NULL stream.\n");
+        return -1;
+    }
+    pthread_mutex_lock(&metrics_lock);
+    if (format == QUEUE_METRICS_JSON)
+    {
+        metrics_dump_json(out);
+    }
+    else
+    {
+        metrics_dump_prometheus(out);
+    }
+    pthread_mutex_unlock(&metrics_lock);
+    return ferror(out) ? -1 : 0;
+}
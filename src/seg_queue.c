@@ -0,0 +1,417 @@
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <stdint.h>
+#include "seg_queue.h"
+#include "epoch.h"
+#include "queue_trace.h"
+#include "contention.h"
+
+#define SEG_QUEUE_CACHE_LINE 64
+
+// Slot states: never written, consumed or poisoned by a dequeuer, and "holds a value"
+#define SEG_SLOT_EMPTY 0ULL
+#define SEG_SLOT_TAKEN (1ULL << 33)
+#define SEG_SLOT_VALUE (1ULL << 32)
+
+struct SegSegment
+{
+    alignas(SEG_QUEUE_CACHE_LINE) atomic_long enqueue_index;
+    alignas(SEG_QUEUE_CACHE_LINE) atomic_long dequeue_index;
+    alignas(SEG_QUEUE_CACHE_LINE) _Atomic(struct SegSegment *) next;
+    alignas(SEG_QUEUE_CACHE_LINE) _Atomic uint64_t slots[SEG_QUEUE_SEGMENT_SIZE];
+};
+
+struct SegQueue
+{
+    alignas(SEG_QUEUE_CACHE_LINE) _Atomic(struct SegSegment *) head;
+    alignas(SEG_QUEUE_CACHE_LINE) _Atomic(struct SegSegment *) tail;
+#if QUEUE_CONTENTION_PROFILE
+    struct ContentionProfile *contention;
+#endif
+};
+
+static struct SegSegment *seg_segment_create(void)
+{
+    /**
+     * Allocates an empty ring segment aligned to a cache line.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(s), where s is `SEG_QUEUE_SEGMENT_SIZE`.
+     *
+     * @return Pointer to the newly allocated segment.
+     */
+    struct SegSegment *segment = (struct SegSegment *)aligned_alloc(SEG_QUEUE_CACHE_LINE, sizeof(struct SegSegment));
+    if (segment == NULL)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed in seg_segment_create(). Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+    atomic_init(&segment->enqueue_index, 0);
+    atomic_init(&segment->dequeue_index, 0);
+    atomic_init(&segment->next, NULL);
+    for (int i = 0; i < SEG_QUEUE_SEGMENT_SIZE; i++)
+    {
+        atomic_init(&segment->slots[i], SEG_SLOT_EMPTY);
+    }
+    return segment;
+}
+
+struct SegQueue *seg_queue_create(void)
+{
+    /**
+     * Allocates and initializes a new segmented lock-free queue.
+     *
+     * The queue is a linked list of fixed-size ring segments. Producers and consumers
+     * claim slots with a fetch-and-add on the segment indices instead of a CAS loop on
+     * shared pointers, so contended operations do not fail and retry; only segment
+     * switches use CAS. Retired segments are freed through the epoch reclamation module.
+     *
+     * @note The created queue must be released with `seg_queue_free` to avoid memory leaks.
+     *
+     * @complexity Time complexity: O(s), where s is `SEG_QUEUE_SEGMENT_SIZE`.
+     *
+     * @return Pointer to the newly created `SegQueue` structure, or NULL if creation fails.
+     */
+    struct SegQueue *queue = (struct SegQueue *)aligned_alloc(SEG_QUEUE_CACHE_LINE, sizeof(struct SegQueue));
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for SegQueue.\n");
+        return NULL;
+    }
+    struct SegSegment *segment = seg_segment_create();
+    atomic_init(&queue->head, segment);
+    atomic_init(&queue->tail, segment);
+#if QUEUE_CONTENTION_PROFILE
+    queue->contention = contention_profile_create();
+#endif
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Segmented QUEUE initialized with %d slots per segment.\n", SEG_QUEUE_SEGMENT_SIZE);
+#endif
+    return queue;
+}
+
+void seg_queue_push(struct SegQueue *queue, int data)
+{
+    /**
+     * Adds the given data at the tail of the segmented queue.
+     *
+     * A producer claims the next slot of the tail segment with a fetch-and-add and
+     * writes the value with a single-word CAS. The CAS only fails if a consumer already
+     * poisoned the slot, in which case the producer claims another one. When the tail
+     * segment is exhausted, a new segment holding the value is linked behind it.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1) amortized.
+     *
+     * @param queue Pointer to the SegQueue structure.
+     * @param data The value to store.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return;
+    }
+    uint64_t item = SEG_SLOT_VALUE | (uint32_t)data;
+
+    epoch_enter();
+    for (;;)
+    {
+        struct SegSegment *tail = atomic_load(&queue->tail);
+        long index = atomic_fetch_add(&tail->enqueue_index, 1);
+        if (index < SEG_QUEUE_SEGMENT_SIZE)
+        {
+            uint64_t expected = SEG_SLOT_EMPTY;
+            if (atomic_compare_exchange_strong(&tail->slots[index], &expected, item))
+            {
+                break;
+            }
+            QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+            continue;
+        }
+
+        QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+        if (tail != atomic_load(&queue->tail))
+        {
+            continue;
+        }
+        struct SegSegment *next = atomic_load(&tail->next);
+        if (next != NULL)
+        {
+            if (!atomic_compare_exchange_strong(&queue->tail, &tail, next))
+            {
+                QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+            }
+            continue;
+        }
+
+        struct SegSegment *segment = seg_segment_create();
+        atomic_store_explicit(&segment->slots[0], item, memory_order_relaxed);
+        atomic_store_explicit(&segment->enqueue_index, 1, memory_order_relaxed);
+        if (atomic_compare_exchange_strong(&tail->next, &next, segment))
+        {
+            atomic_compare_exchange_strong(&queue->tail, &tail, segment);
+            QUEUE_TRACE2(seg_queue_grow, (intptr_t)queue, sizeof(struct SegSegment));
+#if DEBUG_MODE
+            fprintf(stderr, "DEBUG: Segmented QUEUE grew by one segment.\n");
+#endif
+            break;
+        }
+        QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+        free(segment);
+    }
+    epoch_exit();
+}
+
+void seg_queue_push_bulk(struct SegQueue *queue, const int *values, int count)
+{
+    /**
+     * Adds `count` values at the tail of the segmented queue, claiming their slots together.
+     *
+     * A producer reserves a run of slots of the tail segment with one fetch-and-add, instead
+     * of one per value, and fills them in order. If a consumer poisoned one of the slots, the
+     * rest of the run is abandoned (consumers skip unwritten slots) and the remaining values
+     * are reserved again, so they still reach consumers in order. When the tail segment is
+     * exhausted, a new segment pre-filled with up to `SEG_QUEUE_SEGMENT_SIZE` values is
+     * linked behind it.
+     *
+     * @note Safe to call concurrently from any number of threads. Values of one call are not
+     *       interleaved with each other, but may be with values of concurrent pushes.
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(k), where k is `count`, with one contended
+     *             fetch-and-add per segment touched.
+     *
+     * @param queue Pointer to the SegQueue structure.
+     * @param values Pointer to the values to store.
+     * @param count Number of values.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return;
+    }
+    if (!values || count <= 0)
+    {
+        return;
+    }
+
+    int pushed = 0;
+    epoch_enter();
+    while (pushed < count)
+    {
+        struct SegSegment *tail = atomic_load(&queue->tail);
+        long claim = count - pushed < SEG_QUEUE_SEGMENT_SIZE ? count - pushed : SEG_QUEUE_SEGMENT_SIZE;
+        long index = atomic_fetch_add(&tail->enqueue_index, claim);
+        if (index < SEG_QUEUE_SEGMENT_SIZE)
+        {
+            long end = index + claim < SEG_QUEUE_SEGMENT_SIZE ? index + claim : SEG_QUEUE_SEGMENT_SIZE;
+            for (; index < end; index++)
+            {
+                uint64_t expected = SEG_SLOT_EMPTY;
+                if (!atomic_compare_exchange_strong(&tail->slots[index], &expected,
+                                                    SEG_SLOT_VALUE | (uint32_t)values[pushed]))
+                {
+                    QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+                    break;
+                }
+                pushed++;
+            }
+            continue;
+        }
+
+        QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+        if (tail != atomic_load(&queue->tail))
+        {
+            continue;
+        }
+        struct SegSegment *next = atomic_load(&tail->next);
+        if (next != NULL)
+        {
+            if (!atomic_compare_exchange_strong(&queue->tail, &tail, next))
+            {
+                QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+            }
+            continue;
+        }
+
+        struct SegSegment *segment = seg_segment_create();
+        for (long i = 0; i < claim; i++)
+        {
+            atomic_store_explicit(&segment->slots[i], SEG_SLOT_VALUE | (uint32_t)values[pushed + i],
+                                  memory_order_relaxed);
+        }
+        atomic_store_explicit(&segment->enqueue_index, claim, memory_order_relaxed);
+        if (atomic_compare_exchange_strong(&tail->next, &next, segment))
+        {
+            atomic_compare_exchange_strong(&queue->tail, &tail, segment);
+            QUEUE_TRACE2(seg_queue_grow, (intptr_t)queue, sizeof(struct SegSegment));
+#if DEBUG_MODE
+            fprintf(stderr, "DEBUG: Segmented QUEUE grew by one segment.\n");
+#endif
+            pushed += (int)claim;
+            continue;
+        }
+        QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+        free(segment);
+    }
+    epoch_exit();
+}
+
+bool seg_queue_pop(struct SegQueue *queue, int *out_value)
+{
+    /**
+     * Removes the front element of the segmented queue and stores it in `out_value`.
+     *
+     * A consumer claims the next slot of the head segment with a fetch-and-add and
+     * swaps a "taken" marker into it. If the producer that owns the slot has not written
+     * yet, the marker poisons the slot and the consumer moves on. Exhausted head segments
+     * are unlinked and retired to the epoch reclamation module.
+     *
+     * @note Safe to call concurrently from any number of threads.
+     *
+     * @complexity Time complexity: O(1) amortized.
+     *
+     * @param queue Pointer to the SegQueue structure.
+     * @param out_value Pointer to an integer where the removed value will be stored.
+     * @return `true` if an element was removed, `false` if the queue is empty or NULL.
+     */
+    if (!queue)
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop from a NULL QUEUE.\n");
+#endif
+        return false;
+    }
+
+    epoch_enter();
+    for (;;)
+    {
+        struct SegSegment *head = atomic_load(&queue->head);
+        if (atomic_load(&head->dequeue_index) >= atomic_load(&head->enqueue_index) &&
+            atomic_load(&head->next) == NULL)
+        {
+            break;
+        }
+
+        long index = atomic_fetch_add(&head->dequeue_index, 1);
+        if (index < SEG_QUEUE_SEGMENT_SIZE)
+        {
+            uint64_t item = atomic_exchange(&head->slots[index], SEG_SLOT_TAKEN);
+            if (item != SEG_SLOT_EMPTY)
+            {
+                *out_value = (int)(uint32_t)item;
+                epoch_exit();
+                return true;
+            }
+            QUEUE_CONTENTION(queue->contention, CONTENTION_SPIN);
+            continue;
+        }
+
+        struct SegSegment *next = atomic_load(&head->next);
+        if (next == NULL)
+        {
+            break;
+        }
+        struct SegSegment *tail = head;
+        atomic_compare_exchange_strong(&queue->tail, &tail, next);
+        if (atomic_compare_exchange_strong(&queue->head, &head, next))
+        {
+            epoch_retire(head, sizeof(struct SegSegment), free);
+        }
+        else
+        {
+            QUEUE_CONTENTION(queue->contention, CONTENTION_CAS_FAILURE);
+        }
+    }
+    QUEUE_CONTENTION(queue->contention, CONTENTION_EMPTY_STALL);
+    epoch_exit();
+    return false;
+}
+
+bool seg_queue_is_empty(struct SegQueue *queue)
+{
+    /**
+     * Checks if the segmented queue is empty.
+     *
+     * @note Under concurrent pushes and pops the result is only a snapshot.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the SegQueue structure.
+     * @return `true` if the queue is empty or the queue pointer is NULL, `false` otherwise.
+     */
+    if (!queue)
+    {
+        return true;
+    }
+    epoch_enter();
+    struct SegSegment *head = atomic_load(&queue->head);
+    bool empty = atomic_load(&head->dequeue_index) >= atomic_load(&head->enqueue_index) &&
+                 atomic_load(&head->next) == NULL;
+    epoch_exit();
+    return empty;
+}
+
+bool seg_queue_get_contention(struct SegQueue *queue, int thread_slot, struct ContentionStats *out)
+{
+    /**
+     * Reads the contention counters of the segmented queue for one thread slot, or summed over all
+     * threads with `thread_slot` -1.
+     *
+     * CAS failures count slots poisoned before the producer wrote them and lost segment
+     * switches; spins count retries (slots a consumer found unwritten, exhausted
+     * segments); empty stalls count pops that found the queue empty.
+     *
+     * @note Counting is compiled in with `-DQUEUE_CONTENTION_PROFILE=1` (`make contention`);
+     *       otherwise the call returns `false` and zeroed counters.
+     *
+     * @complexity Time complexity: O(1) for one slot, O(t) for the sum over t slots.
+     *
+     * @param queue Pointer to the SegQueue structure.
+     * @param thread_slot A slot returned by `queue_thread_slot`, or -1 for all threads.
+     * @param out Pointer to the structure that receives the counters.
+     * @return `true` if counters were read, `false` otherwise.
+     */
+#if QUEUE_CONTENTION_PROFILE
+    return contention_profile_get(queue ? queue->contention : NULL, thread_slot, out);
+#else
+    (void)queue;
+    return contention_profile_get(NULL, thread_slot, out);
+#endif
+}
+
+void seg_queue_free(struct SegQueue *queue)
+{
+    /**
+     * Frees the segmented queue and every segment still linked in it.
+     *
+     * @note No other thread may access the queue during or after this call.
+     *
+     * @complexity Time complexity: O(n / s), where n is the number of elements and s is
+     *             `SEG_QUEUE_SEGMENT_SIZE`.
+     *
+     * @param queue Pointer to the SegQueue structure.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "INFO: QUEUE is already NULL. Skipping free.\n");
+        return;
+    }
+    struct SegSegment *iterator = atomic_load(&queue->head);
+    while (iterator != NULL)
+    {
+        struct SegSegment *temp = iterator;
+        iterator = atomic_load(&iterator->next);
+        free(temp);
+    }
+#if QUEUE_CONTENTION_PROFILE
+    contention_profile_free(queue->contention);
+#endif
+    free(queue);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Segmented QUEUE has been freed.\n");
+#endif
+}
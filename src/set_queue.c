@@ -0,0 +1,472 @@
+#include <string.h>
+#include "set_queue.h"
+#include "chunk_queue.h"
+#include "queue_trace.h"
+
+// Fibonacci hashing multiplier (2^64 / golden ratio)
+#define SET_QUEUE_HASH_MULTIPLIER 0x9E3779B97F4A7C15ull
+
+struct SetQueue
+{
+    struct ChunkQueue *order;
+    uint64_t *bits;
+    int *keys;
+    size_t slots;
+    int slot_bits;
+    size_t count;
+    bool range;
+    int min_value;
+    int max_value;
+};
+
+static inline bool set_queue_bit(const uint64_t *bits, size_t index)
+{
+    /**
+     * Tests bit `index` of a bitmap. In hash mode bit i is set iff slot i holds a key;
+     * in range mode bit i is set iff `min_value + i` is queued.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    return (bits[index >> 6] >> (index & 63)) & 1;
+}
+
+static inline void set_queue_set_bit(uint64_t *bits, size_t index)
+{
+    /**
+     * Sets bit `index` of a bitmap: the slot is occupied, or the value is queued.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    bits[index >> 6] |= 1ull << (index & 63);
+}
+
+static inline void set_queue_clear_bit(uint64_t *bits, size_t index)
+{
+    /**
+     * Clears bit `index` of a bitmap: the slot is empty, or the value is not queued.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    bits[index >> 6] &= ~(1ull << (index & 63));
+}
+
+static inline size_t set_queue_words(size_t bits)
+{
+    /**
+     * Returns the number of 64-bit words holding a bitmap of `bits` bits.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    return (bits + 63) / 64;
+}
+
+static inline size_t set_queue_home(const struct SetQueue *queue, int value)
+{
+    /**
+     * Returns the home slot of `value`: the top `slot_bits` bits of a Fibonacci hash, so
+     * nearby IDs spread over the table. A key lives at its home slot or further along the
+     * probe run that starts there, with no empty slot in between.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    return (size_t)(((uint64_t)(uint32_t)value * SET_QUEUE_HASH_MULTIPLIER) >> (64 - queue->slot_bits));
+}
+
+static struct SetQueue *set_queue_alloc(void)
+{
+    /**
+     * Allocates a zeroed `SetQueue` with its FIFO; the create functions then add the hash
+     * set or the bitmap.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @return The queue, or NULL if an allocation fails.
+     */
+    struct SetQueue *queue = (struct SetQueue *)calloc(1, sizeof(struct SetQueue));
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for SetQueue.\n");
+        return NULL;
+    }
+    queue->order = chunk_queue_create(CHUNK_QUEUE_PLAIN);
+    if (!queue->order)
+    {
+        free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+struct SetQueue *set_queue_create(void)
+{
+    /**
+     * Allocates and initializes a new deduplicating queue for any `int` values.
+     *
+     * Values are kept in FIFO order in a `ChunkQueue`, and the values currently queued
+     * are tracked in an open-addressing hash set with linear probing. Pushing a value
+     * that is already queued does nothing, so the queue replaces the O(n)
+     * `queue_search` + `queue_push` pattern with O(1) operations.
+     *
+     * @note The created queue must be released with `set_queue_free` to avoid memory leaks.
+     * @note The queue is not thread-safe.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @return Pointer to the newly created `SetQueue` structure, or NULL if creation fails.
+     */
+    struct SetQueue *queue = set_queue_alloc();
+    if (!queue)
+    {
+        return NULL;
+    }
+    queue->slots = SET_QUEUE_INITIAL_SLOTS;
+    queue->slot_bits = __builtin_ctzll(SET_QUEUE_INITIAL_SLOTS);
+    queue->keys = (int *)malloc(queue->slots * sizeof(int));
+    queue->bits = (uint64_t *)calloc(set_queue_words(queue->slots), sizeof(uint64_t));
+    if (!queue->keys || !queue->bits)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for SetQueue hash set.\n");
+        set_queue_free(queue);
+        return NULL;
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Set QUEUE initialized (hash set).\n");
+#endif
+    return queue;
+}
+
+struct SetQueue *set_queue_create_range(int min_value, int max_value)
+{
+    /**
+     * Allocates and initializes a new deduplicating queue for values in
+     * [`min_value`, `max_value`].
+     *
+     * Membership is a dense bitmap with one bit per possible value instead of a hash
+     * set, which is smaller and faster when the range is not much larger than the
+     * number of values queued at once (e.g. 1M work IDs take 128 KB).
+     *
+     * @note The created queue must be released with `set_queue_free` to avoid memory leaks.
+     * @note The queue is not thread-safe.
+     *
+     * @complexity Time complexity: O(r), where r is the size of the range (the bitmap is
+     *             zeroed).
+     *
+     * @param min_value Smallest value the queue accepts.
+     * @param max_value Largest value the queue accepts.
+     * @return Pointer to the newly created `SetQueue` structure, or NULL if the range is
+     *         empty or creation fails.
+     */
+    if (min_value > max_value)
+    {
+        fprintf(stderr, "ERROR: Invalid SetQueue range [%d, %d].\n", min_value, max_value);
+        return NULL;
+    }
+    struct SetQueue *queue = set_queue_alloc();
+    if (!queue)
+    {
+        return NULL;
+    }
+    queue->range = true;
+    queue->min_value = min_value;
+    queue->max_value = max_value;
+    queue->slots = (size_t)((int64_t)max_value - min_value + 1);
+    queue->bits = (uint64_t *)calloc(set_queue_words(queue->slots), sizeof(uint64_t));
+    if (!queue->bits)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for SetQueue bitmap.\n");
+        set_queue_free(queue);
+        return NULL;
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Set QUEUE initialized (bitmap of %zu values).\n", queue->slots);
+#endif
+    return queue;
+}
+
+static size_t set_queue_find(const struct SetQueue *queue, int value, bool *found)
+{
+    /**
+     * Probes the hash set for `value` and returns its slot, or the empty slot that ends
+     * its probe sequence.
+     *
+     * @complexity Time complexity: O(1) expected at a load factor of at most 1/2.
+     */
+    size_t mask = queue->slots - 1;
+    size_t slot = set_queue_home(queue, value);
+    while (set_queue_bit(queue->bits, slot))
+    {
+        if (queue->keys[slot] == value)
+        {
+            *found = true;
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    *found = false;
+    return slot;
+}
+
+static void set_queue_grow(struct SetQueue *queue)
+{
+    /**
+     * Doubles the hash set and reinserts every queued value.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(s), where s is the number of slots.
+     */
+    int *old_keys = queue->keys;
+    uint64_t *old_bits = queue->bits;
+    size_t old_slots = queue->slots;
+    queue->slots = old_slots * 2;
+    queue->slot_bits++;
+    queue->keys = (int *)malloc(queue->slots * sizeof(int));
+    queue->bits = (uint64_t *)calloc(set_queue_words(queue->slots), sizeof(uint64_t));
+    if (!queue->keys || !queue->bits)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed in set_queue_push(). Exiting...\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < old_slots; i++)
+    {
+        if (set_queue_bit(old_bits, i))
+        {
+            bool found;
+            size_t slot = set_queue_find(queue, old_keys[i], &found);
+            queue->keys[slot] = old_keys[i];
+            set_queue_set_bit(queue->bits, slot);
+        }
+    }
+    free(old_keys);
+    free(old_bits);
+    QUEUE_TRACE3(set_queue_grow, (intptr_t)queue, old_slots, queue->slots);
+}
+
+static void set_queue_erase(struct SetQueue *queue, int value)
+{
+    /**
+     * Removes `value` from the hash set with backward-shift deletion: later entries of
+     * the same probe run move into the hole, so no tombstones accumulate and lookups
+     * stay short however many values pass through the queue.
+     *
+     * @complexity Time complexity: O(1) expected.
+     */
+    bool found;
+    size_t hole = set_queue_find(queue, value, &found);
+    if (!found)
+    {
+        return;
+    }
+    size_t mask = queue->slots - 1;
+    size_t next = (hole + 1) & mask;
+    while (set_queue_bit(queue->bits, next))
+    {
+        size_t home = set_queue_home(queue, queue->keys[next]);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            queue->keys[hole] = queue->keys[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    set_queue_clear_bit(queue->bits, hole);
+}
+
+bool set_queue_push(struct SetQueue *queue, int data)
+{
+    /**
+     * Adds `data` at the tail of the queue unless it is already queued.
+     *
+     * A value can be pushed again once it has been popped.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O(1) amortized (expected, for the hash set).
+     *
+     * @param queue Pointer to the SetQueue structure.
+     * @param data The value to store.
+     * @return `true` if the value was added, `false` if it was already queued, is outside
+     *         the range of a range queue, or the queue is NULL.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "ERROR: Attempt to push to a NULL QUEUE.\n");
+        return false;
+    }
+    if (queue->range)
+    {
+        if (data < queue->min_value || data > queue->max_value)
+        {
+            fprintf(stderr, "ERROR: Value %d outside SetQueue range [%d, %d].\n", data, queue->min_value,
+                    queue->max_value);
+            return false;
+        }
+        size_t index = (size_t)((int64_t)data - queue->min_value);
+        if (set_queue_bit(queue->bits, index))
+        {
+            return false;
+        }
+        set_queue_set_bit(queue->bits, index);
+    }
+    else
+    {
+        bool found;
+        size_t slot = set_queue_find(queue, data, &found);
+        if (found)
+        {
+            return false;
+        }
+        if (2 * (queue->count + 1) > queue->slots)
+        {
+            set_queue_grow(queue);
+            slot = set_queue_find(queue, data, &found);
+        }
+        queue->keys[slot] = data;
+        set_queue_set_bit(queue->bits, slot);
+    }
+    queue->count++;
+    chunk_queue_push(queue->order, data);
+    return true;
+}
+
+bool set_queue_pop(struct SetQueue *queue, int *out_value)
+{
+    /**
+     * Removes the front element of the queue, stores it in `out_value` and removes it
+     * from the membership set.
+     *
+     * @complexity Time complexity: O(1) amortized (expected, for the hash set).
+     *
+     * @param queue Pointer to the SetQueue structure.
+     * @param out_value Pointer to an integer where the removed value will be stored.
+     * @return `true` if an element was removed, `false` if the queue is empty or NULL.
+     */
+    int value;
+    if (!queue || !chunk_queue_pop(queue->order, &value))
+    {
+#if DEBUG_MODE
+        fprintf(stderr, "WARNING: Attempt to pop from an empty or NULL QUEUE.\n");
+#endif
+        return false;
+    }
+    if (queue->range)
+    {
+        set_queue_clear_bit(queue->bits, (size_t)((int64_t)value - queue->min_value));
+    }
+    else
+    {
+        set_queue_erase(queue, value);
+    }
+    queue->count--;
+    *out_value = value;
+    return true;
+}
+
+bool set_queue_peek(struct SetQueue *queue, int *out_value)
+{
+    /**
+     * Retrieves the front element of the queue without removing it.
+     *
+     * @complexity Time complexity: O(1) amortized.
+     *
+     * @param queue Pointer to the SetQueue structure.
+     * @param out_value Pointer to an integer where the front value will be stored.
+     * @return `true` if the queue has an element, `false` if it is empty or NULL.
+     */
+    return queue ? chunk_queue_peek(queue->order, out_value) : false;
+}
+
+bool set_queue_contains(struct SetQueue *queue, int data)
+{
+    /**
+     * Checks whether `data` is currently queued.
+     *
+     * @complexity Time complexity: O(1) (expected, for the hash set).
+     *
+     * @param queue Pointer to the SetQueue structure.
+     * @param data The value to look up.
+     * @return `true` if the value is queued, `false` otherwise or if the queue is NULL.
+     */
+    if (!queue)
+    {
+        return false;
+    }
+    if (queue->range)
+    {
+        return data >= queue->min_value && data <= queue->max_value &&
+               set_queue_bit(queue->bits, (size_t)((int64_t)data - queue->min_value));
+    }
+    bool found;
+    set_queue_find(queue, data, &found);
+    return found;
+}
+
+size_t set_queue_size(struct SetQueue *queue)
+{
+    /**
+     * Returns the number of elements in the queue.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the SetQueue structure.
+     * @return The number of elements, or 0 if the queue pointer is NULL.
+     */
+    return queue ? queue->count : 0;
+}
+
+bool set_queue_is_empty(struct SetQueue *queue)
+{
+    /**
+     * Checks if the queue is empty.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the SetQueue structure.
+     * @return `true` if the queue is empty or the queue pointer is NULL, `false` otherwise.
+     */
+    return (queue == NULL || queue->count == 0);
+}
+
+size_t set_queue_memory_usage(struct SetQueue *queue)
+{
+    /**
+     * Returns the number of bytes the queue allocated: the structure, the chunked FIFO
+     * and the hash set or bitmap.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param queue Pointer to the SetQueue structure.
+     * @return The allocated size in bytes, or 0 if the queue pointer is NULL.
+     */
+    if (!queue)
+    {
+        return 0;
+    }
+    size_t bytes = sizeof(struct SetQueue) + chunk_queue_memory_usage(queue->order) +
+                   set_queue_words(queue->slots) * sizeof(uint64_t);
+    return queue->range ? bytes : bytes + queue->slots * sizeof(int);
+}
+
+void set_queue_free(struct SetQueue *queue)
+{
+    /**
+     * Frees the queue, its FIFO and its membership set.
+     *
+     * @complexity Time complexity: O(n / c), where n is the number of elements and c is
+     *             `CHUNK_QUEUE_CHUNK_SIZE`.
+     *
+     * @param queue Pointer to the SetQueue structure.
+     */
+    if (!queue)
+    {
+        fprintf(stderr, "INFO: QUEUE is already NULL. Skipping free.\n");
+        return;
+    }
+    chunk_queue_free(queue->order);
+    free(queue->keys);
+    free(queue->bits);
+    free(queue);
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Set QUEUE has been freed.\n");
+#endif
+}
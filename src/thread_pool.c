@@ -0,0 +1,715 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdatomic.h>
+#include <stdalign.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include "thread_pool.h"
+#include "queue.h"
+#include "ms_queue.h"
+#include "seg_queue.h"
+#include "fc_queue.h"
+#include "elim_stack.h"
+#include "queue_trace.h"
+
+#define THREAD_POOL_CACHE_LINE 64
+
+// A submitted function and its argument, stored in a slot whose index travels through the queue
+struct ThreadPoolTask
+{
+    void (*fn)(void *arg);
+    void *arg;
+};
+
+// Push/pop over the concurrent queue chosen at creation
+struct ThreadPoolOps
+{
+    void *(*create)(void);
+    void (*push)(void *queue, int data);
+    bool (*pop)(void *queue, int *out_value);
+    void (*destroy)(void *queue);
+};
+
+// Per-worker counters, on their own cache line since only the worker writes them
+struct ThreadPoolWorker
+{
+    alignas(THREAD_POOL_CACHE_LINE) struct ThreadPool *pool;
+    pthread_t thread;
+    _Atomic uint64_t executed;
+    _Atomic uint64_t parks;
+};
+
+struct ThreadPool
+{
+    const struct ThreadPoolOps *ops;
+    void *queue;
+    struct ElimStack *free_slots;
+    struct ThreadPoolTask *tasks;
+    int capacity;
+    int worker_count;
+    struct ThreadPoolWorker *workers;
+    bool joined;
+    _Atomic bool stopping;
+    _Atomic long in_flight;
+    _Atomic int sleepers;
+    _Atomic int waiters;
+    pthread_mutex_t lock;
+    pthread_cond_t work_available;
+    pthread_cond_t all_done;
+    _Atomic uint64_t helped;
+    _Atomic uint64_t wakeups;
+    _Atomic uint64_t full_stalls;
+};
+
+// A chunk of a parallel_for range and the countdown of chunks still running
+struct ThreadPoolRange
+{
+    void (*fn)(void *arg, long begin, long end);
+    void *arg;
+    long begin;
+    long end;
+    _Atomic long *remaining;
+};
+
+static void *pool_seg_create(void)
+{
+    /**
+     * Creates the `seg_queue` that carries slot ids to the workers.
+     * @complexity Time complexity: O(1).
+     */
+    return seg_queue_create();
+}
+
+static void pool_seg_push(void *queue, int data)
+{
+    /**
+     * Adapts `seg_queue_push` to `ThreadPoolOps`.
+     * @complexity Time complexity: O(1) amortized.
+     */
+    seg_queue_push(queue, data);
+}
+
+static bool pool_seg_pop(void *queue, int *out_value)
+{
+    /**
+     * Adapts `seg_queue_pop` to `ThreadPoolOps`.
+     * @complexity Time complexity: O(1).
+     */
+    return seg_queue_pop(queue, out_value);
+}
+
+static void pool_seg_destroy(void *queue)
+{
+    /**
+     * Frees the `seg_queue` of a pool.
+     *
+     * @complexity Time complexity: O(s), where s is the number of segments.
+     */
+    seg_queue_free(queue);
+}
+
+static void *pool_ms_create(void)
+{
+    /**
+     * Creates the `ms_queue` that carries slot ids to the workers, with hazard pointer
+     * reclamation.
+     * @complexity Time complexity: O(1).
+     */
+    return ms_queue_create(MS_QUEUE_RECLAIM_HAZARD);
+}
+
+static void pool_ms_push(void *queue, int data)
+{
+    /**
+     * Adapts `ms_queue_push` to `ThreadPoolOps`.
+     * @complexity Time complexity: O(1).
+     */
+    ms_queue_push(queue, data);
+}
+
+static bool pool_ms_pop(void *queue, int *out_value)
+{
+    /**
+     * Adapts `ms_queue_pop` to `ThreadPoolOps`.
+     * @complexity Time complexity: O(1).
+     */
+    return ms_queue_pop(queue, out_value);
+}
+
+static void pool_ms_destroy(void *queue)
+{
+    /**
+     * Frees the `ms_queue` of a pool.
+     *
+     * @complexity Time complexity: O(n), where n is the number of queued ids.
+     */
+    ms_queue_free(queue);
+}
+
+// Flat-combining wrapper and the LinkedList it serializes
+struct ThreadPoolFCQueue
+{
+    struct FCQueue *fc;
+    struct LinkedList *list;
+};
+
+static void *pool_fc_create(void)
+{
+    /**
+     * Creates a `LinkedList` and the flat-combining wrapper that serializes it. On
+     * failure, everything allocated so far is released.
+     * @complexity Time complexity: O(1).
+     *
+     * @return The queue, or NULL if an allocation fails.
+     */
+    struct ThreadPoolFCQueue *queue = (struct ThreadPoolFCQueue *)malloc(sizeof(struct ThreadPoolFCQueue));
+    if (!queue)
+    {
+        return NULL;
+    }
+    queue->list = queue_create();
+    queue->fc = queue->list ? fc_queue_create(queue->list, &linked_list_ops) : NULL;
+    if (!queue->fc)
+    {
+        free(queue->list);
+        free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+static void pool_fc_push(void *queue, int data)
+{
+    /**
+     * Adapts `fc_queue_push` to `ThreadPoolOps`.
+     * @complexity Time complexity: O(1).
+     */
+    fc_queue_push(((struct ThreadPoolFCQueue *)queue)->fc, data);
+}
+
+static bool pool_fc_pop(void *queue, int *out_value)
+{
+    /**
+     * Adapts `fc_queue_pop` to `ThreadPoolOps`.
+     * @complexity Time complexity: O(1).
+     */
+    return fc_queue_pop(((struct ThreadPoolFCQueue *)queue)->fc, out_value);
+}
+
+static void pool_fc_destroy(void *queue)
+{
+    /**
+     * Frees the flat-combining wrapper and the `LinkedList` behind it.
+     *
+     * @complexity Time complexity: O(n), where n is the number of queued ids.
+     */
+    struct ThreadPoolFCQueue *fc_queue = (struct ThreadPoolFCQueue *)queue;
+    fc_queue_free(fc_queue->fc);
+    if (!queue_is_empty(fc_queue->list))
+    {
+        queue_free(fc_queue->list);
+    }
+    free(fc_queue);
+}
+
+static const struct ThreadPoolOps thread_pool_ops[] = {
+    [THREAD_POOL_SEG_QUEUE] = {pool_seg_create, pool_seg_push, pool_seg_pop, pool_seg_destroy},
+    [THREAD_POOL_MS_QUEUE] = {pool_ms_create, pool_ms_push, pool_ms_pop, pool_ms_destroy},
+    [THREAD_POOL_FC_QUEUE] = {pool_fc_create, pool_fc_push, pool_fc_pop, pool_fc_destroy},
+};
+
+static void thread_pool_count(_Atomic uint64_t *counter)
+{
+    /**
+     * Increments a per-worker counter. Only its worker writes it, so a relaxed load and
+     * store suffice; `thread_pool_get_stats` reads it from other threads.
+     * @complexity Time complexity: O(1).
+     */
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + 1, memory_order_relaxed);
+}
+
+static void thread_pool_run(struct ThreadPool *pool, int slot)
+{
+    /**
+     * Runs the task in `slot` and marks it finished.
+     *
+     * The slot is copied and returned to the free list before the task runs, so a task
+     * that submits more work can reuse it. The last task to finish wakes the threads
+     * blocked in `thread_pool_wait`.
+     *
+     * @complexity Time complexity: O(1) plus the task itself.
+     */
+    struct ThreadPoolTask task = pool->tasks[slot];
+    elim_stack_push(pool->free_slots, slot);
+    task.fn(task.arg);
+    if (atomic_fetch_sub(&pool->in_flight, 1) == 1 && atomic_load(&pool->waiters) > 0)
+    {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->all_done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static bool thread_pool_help(struct ThreadPool *pool)
+{
+    /**
+     * Runs one queued task in the calling thread, if there is one.
+     *
+     * Used by submitters when every slot is taken and by threads that wait for tasks, so
+     * they make progress instead of blocking a core.
+     *
+     * @complexity Time complexity: O(1) plus the task itself.
+     *
+     * @return `true` if a task was run, `false` if the queue was empty.
+     */
+    int slot;
+    if (!pool->ops->pop(pool->queue, &slot))
+    {
+        return false;
+    }
+    atomic_fetch_add_explicit(&pool->helped, 1, memory_order_relaxed);
+    thread_pool_run(pool, slot);
+    return true;
+}
+
+static void *thread_pool_worker_run(void *arg)
+{
+    /**
+     * Worker loop: pops and runs tasks, polls a few times when the queue runs dry, then
+     * blocks until a submission signals it.
+     *
+     * A worker registers as a sleeper under the lock and pops once more before waiting.
+     * Submitters push before they read the sleeper count, so either the worker finds the
+     * task or the submitter sees the sleeper and signals it. Each signal consumes one
+     * registration, so a burst of submissions wakes one sleeper per task instead of
+     * locking on every submit until the woken worker gets to run. A spurious wakeup
+     * leaves one registration too many, which only costs a later spare signal. On
+     * shutdown the worker keeps popping until the queue is empty, so no accepted task is
+     * dropped.
+     *
+     * @complexity Time complexity: O(1) per task.
+     */
+    struct ThreadPoolWorker *worker = (struct ThreadPoolWorker *)arg;
+    struct ThreadPool *pool = worker->pool;
+    int spins = 0;
+    int slot;
+    for (;;)
+    {
+        if (pool->ops->pop(pool->queue, &slot))
+        {
+            thread_pool_run(pool, slot);
+            thread_pool_count(&worker->executed);
+            spins = 0;
+            continue;
+        }
+        if (++spins < THREAD_POOL_SPINS_BEFORE_PARK && !atomic_load_explicit(&pool->stopping, memory_order_relaxed))
+        {
+            sched_yield();
+            continue;
+        }
+        spins = 0;
+
+        pthread_mutex_lock(&pool->lock);
+        bool registered = false;
+        bool found;
+        for (;;)
+        {
+            if (!registered)
+            {
+                atomic_fetch_add(&pool->sleepers, 1);
+                atomic_thread_fence(memory_order_seq_cst);
+                registered = true;
+            }
+            found = pool->ops->pop(pool->queue, &slot);
+            if (found || atomic_load(&pool->stopping))
+            {
+                break;
+            }
+            thread_pool_count(&worker->parks);
+            QUEUE_TRACE2(thread_pool_wait, (intptr_t)pool, atomic_load_explicit(&pool->sleepers, memory_order_relaxed));
+            pthread_cond_wait(&pool->work_available, &pool->lock);
+            // The submitter that signalled took our registration with it
+            registered = false;
+        }
+        if (registered)
+        {
+            atomic_fetch_sub(&pool->sleepers, 1);
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        if (!found)
+        {
+            return NULL;
+        }
+        thread_pool_run(pool, slot);
+        thread_pool_count(&worker->executed);
+    }
+}
+
+struct ThreadPool *thread_pool_create(int workers, enum ThreadPoolQueue queue, int capacity)
+{
+    /**
+     * Creates a pool of worker threads that run submitted tasks.
+     *
+     * Tasks are stored in a table of `capacity` slots. The index of each submitted slot is
+     * pushed through the chosen concurrent queue of the library, and free slots are kept
+     * on a lock-free stack, so dispatching a task takes no lock. Idle workers block on a
+     * condition variable and cost nothing while the pool has no work.
+     *
+     * @note The created pool must be released with `thread_pool_free`.
+     * @note The queues index per-thread state by `queue_thread_slot()`, so workers plus
+     *       submitting threads should stay within `QUEUE_MAX_THREADS`.
+     *
+     * @complexity Time complexity: O(w + c), where w is the number of workers and c the
+     *             capacity.
+     *
+     * @param workers Number of worker threads (0 selects one per online CPU).
+     * @param queue Concurrent queue that carries tasks to the workers.
+     * @param capacity Maximum number of unfinished tasks (0 selects
+     *                 `THREAD_POOL_DEFAULT_CAPACITY`).
+     * @return Pointer to the new pool, or NULL if creation fails.
+     */
+    if (queue < THREAD_POOL_SEG_QUEUE || queue > THREAD_POOL_FC_QUEUE)
+    {
+        fprintf(stderr, "ERROR: Unknown thread pool queue %d.\n", (int)queue);
+        return NULL;
+    }
+    if (workers <= 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (capacity <= 0)
+    {
+        capacity = THREAD_POOL_DEFAULT_CAPACITY;
+    }
+
+    struct ThreadPool *pool = (struct ThreadPool *)calloc(1, sizeof(struct ThreadPool));
+    if (!pool)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for ThreadPool.\n");
+        return NULL;
+    }
+    pool->ops = &thread_pool_ops[queue];
+    pool->capacity = capacity;
+    pool->queue = pool->ops->create();
+    pool->free_slots = elim_stack_create(ELIM_STACK_DEFAULT_WIDTH);
+    pool->tasks = (struct ThreadPoolTask *)malloc((size_t)capacity * sizeof(struct ThreadPoolTask));
+    pool->workers = (struct ThreadPoolWorker *)aligned_alloc(
+        THREAD_POOL_CACHE_LINE, (size_t)workers * sizeof(struct ThreadPoolWorker));
+    if (!pool->queue || !pool->free_slots || !pool->tasks || !pool->workers)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for ThreadPool.\n");
+        pool->joined = true;
+        thread_pool_free(pool);
+        return NULL;
+    }
+    for (int slot = capacity - 1; slot >= 0; slot--)
+    {
+        elim_stack_push(pool->free_slots, slot);
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_available, NULL);
+    pthread_cond_init(&pool->all_done, NULL);
+
+    for (int i = 0; i < workers; i++)
+    {
+        pool->workers[i].pool = pool;
+        atomic_init(&pool->workers[i].executed, 0);
+        atomic_init(&pool->workers[i].parks, 0);
+        if (pthread_create(&pool->workers[i].thread, NULL, thread_pool_worker_run, &pool->workers[i]) != 0)
+        {
+            fprintf(stderr, "ERROR: Failed to start thread pool worker %d.\n", i);
+            pool->worker_count = i;
+            thread_pool_free(pool);
+            return NULL;
+        }
+        pool->worker_count = i + 1;
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Thread pool started %d workers with %d task slots.\n", workers, capacity);
+#endif
+    return pool;
+}
+
+bool thread_pool_submit(struct ThreadPool *pool, void (*fn)(void *arg), void *arg)
+{
+    /**
+     * Queues `fn(arg)` to run on a worker thread.
+     *
+     * If all `capacity` slots hold unfinished tasks, the caller runs queued tasks itself
+     * until a slot frees up, which throttles producers that outpace the workers without
+     * deadlocking when a task submits more work.
+     *
+     * @complexity Time complexity: O(1) when a slot is free.
+     *
+     * @param pool Pointer to the ThreadPool structure.
+     * @param fn Function to run.
+     * @param arg Argument passed to `fn`.
+     * @return `true` if the task was queued, `false` if the pool is shutting down or the
+     *         arguments are NULL.
+     */
+    if (!pool || !fn)
+    {
+        fprintf(stderr, "ERROR: Attempt to submit to a NULL thread pool or a NULL task.\n");
+        return false;
+    }
+    if (atomic_load_explicit(&pool->stopping, memory_order_relaxed))
+    {
+        fprintf(stderr, "ERROR: Thread pool is shutting down; task rejected.\n");
+        return false;
+    }
+    int slot;
+    if (!elim_stack_pop(pool->free_slots, &slot))
+    {
+        atomic_fetch_add_explicit(&pool->full_stalls, 1, memory_order_relaxed);
+        do
+        {
+            if (!thread_pool_help(pool))
+            {
+                sched_yield();
+            }
+        } while (!elim_stack_pop(pool->free_slots, &slot));
+    }
+    pool->tasks[slot] = (struct ThreadPoolTask){fn, arg};
+    atomic_fetch_add(&pool->in_flight, 1);
+    pool->ops->push(pool->queue, slot);
+
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&pool->sleepers, memory_order_relaxed) > 0)
+    {
+        pthread_mutex_lock(&pool->lock);
+        if (atomic_load(&pool->sleepers) > 0)
+        {
+            atomic_fetch_sub(&pool->sleepers, 1);
+            pthread_cond_signal(&pool->work_available);
+            atomic_fetch_add_explicit(&pool->wakeups, 1, memory_order_relaxed);
+        }
+        pthread_mutex_unlock(&pool->lock);
+    }
+    return true;
+}
+
+void thread_pool_wait(struct ThreadPool *pool)
+{
+    /**
+     * Blocks until every submitted task has finished.
+     *
+     * The caller first runs queued tasks itself, then sleeps until the last running task
+     * finishes. Tasks submitted by other threads while waiting are waited for as well.
+     *
+     * @note Must not be called from inside a task: the task itself never finishes while
+     *       it waits. Use `thread_pool_parallel_for` for nested parallelism.
+     *
+     * @complexity Time complexity: O(n) for the n tasks run by the caller, plus the wait.
+     *
+     * @param pool Pointer to the ThreadPool structure.
+     */
+    if (!pool)
+    {
+        return;
+    }
+    while (thread_pool_help(pool))
+    {
+    }
+    pthread_mutex_lock(&pool->lock);
+    atomic_fetch_add(&pool->waiters, 1);
+    while (atomic_load(&pool->in_flight) > 0)
+    {
+        pthread_cond_wait(&pool->all_done, &pool->lock);
+    }
+    atomic_fetch_sub(&pool->waiters, 1);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void thread_pool_range_run(void *arg)
+{
+    /**
+     * Task body of one `thread_pool_parallel_for` chunk: runs `fn` on the chunk, then
+     * counts it down with a release store so the caller sees its writes.
+     *
+     * @complexity Time complexity: O(1) plus `fn`.
+     */
+    struct ThreadPoolRange *range = (struct ThreadPoolRange *)arg;
+    range->fn(range->arg, range->begin, range->end);
+    atomic_fetch_sub_explicit(range->remaining, 1, memory_order_release);
+}
+
+void thread_pool_parallel_for(struct ThreadPool *pool, long begin, long end, long grain,
+                              void (*fn)(void *arg, long begin, long end), void *arg)
+{
+    /**
+     * Calls `fn(arg, chunk_begin, chunk_end)` over `[begin, end)` split into chunks of
+     * `grain` indices, in parallel on the pool, and returns when every chunk is done.
+     *
+     * The caller submits all chunks but the first, runs the first itself, then runs
+     * queued tasks until the other chunks finish. Since the caller never sleeps while its
+     * chunks are pending, `parallel_for` may be nested inside pool tasks.
+     *
+     * @note Exits the program with `EXIT_FAILURE` if memory allocation fails.
+     *
+     * @complexity Time complexity: O((end - begin) / p) with p busy threads, plus
+     *             O((end - begin) / grain) dispatches.
+     *
+     * @param pool Pointer to the ThreadPool structure.
+     * @param begin First index.
+     * @param end One past the last index.
+     * @param grain Indices per chunk; 0 splits the range into four chunks per worker.
+     * @param fn Function called for each chunk.
+     * @param arg Argument passed to `fn`.
+     */
+    if (!pool || !fn || begin >= end)
+    {
+        return;
+    }
+    long count = end - begin;
+    if (grain <= 0)
+    {
+        long chunks = 4L * pool->worker_count;
+        grain = (count + chunks - 1) / chunks;
+    }
+    long chunks = (count + grain - 1) / grain;
+    struct ThreadPoolRange *ranges = (struct ThreadPoolRange *)malloc((size_t)chunks * sizeof(struct ThreadPoolRange));
+    if (!ranges)
+    {
+        fprintf(stderr, "ERROR: Memory allocation failed for parallel_for ranges.\n");
+        exit(EXIT_FAILURE);
+    }
+    _Atomic long remaining = chunks;
+    for (long c = 0; c < chunks; c++)
+    {
+        long chunk_begin = begin + c * grain;
+        ranges[c] = (struct ThreadPoolRange){fn, arg, chunk_begin, chunk_begin + grain < end ? chunk_begin + grain : end,
+                                             &remaining};
+    }
+    for (long c = 1; c < chunks; c++)
+    {
+        if (!thread_pool_submit(pool, thread_pool_range_run, &ranges[c]))
+        {
+            thread_pool_range_run(&ranges[c]);
+        }
+    }
+    thread_pool_range_run(&ranges[0]);
+    while (atomic_load_explicit(&remaining, memory_order_acquire) > 0)
+    {
+        if (!thread_pool_help(pool))
+        {
+            sched_yield();
+        }
+    }
+    free(ranges);
+}
+
+int thread_pool_size(struct ThreadPool *pool)
+{
+    /**
+     * Returns the number of worker threads.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param pool Pointer to the ThreadPool structure.
+     * @return The number of workers, or 0 if the pool pointer is NULL.
+     */
+    return pool ? pool->worker_count : 0;
+}
+
+void thread_pool_get_stats(struct ThreadPool *pool, struct ThreadPoolStats *out)
+{
+    /**
+     * Copies the pool's dispatch counters into `out`.
+     *
+     * `executed` counts tasks run by workers and `helped` tasks run by submitting or
+     * waiting threads; `submitted` includes the tasks still queued or running. `parks`
+     * counts the times a worker blocked, `wakeups` the signals sent to sleeping workers
+     * and `full_stalls` the submissions that found every slot taken.
+     *
+     * @complexity Time complexity: O(w), where w is the number of workers.
+     *
+     * @param pool Pointer to the ThreadPool structure.
+     * @param out Pointer to the structure that receives the counters.
+     */
+    if (!pool || !out)
+    {
+        return;
+    }
+    *out = (struct ThreadPoolStats){0};
+    for (int i = 0; i < pool->worker_count; i++)
+    {
+        out->executed += atomic_load_explicit(&pool->workers[i].executed, memory_order_relaxed);
+        out->parks += atomic_load_explicit(&pool->workers[i].parks, memory_order_relaxed);
+    }
+    out->helped = atomic_load_explicit(&pool->helped, memory_order_relaxed);
+    out->wakeups = atomic_load_explicit(&pool->wakeups, memory_order_relaxed);
+    out->full_stalls = atomic_load_explicit(&pool->full_stalls, memory_order_relaxed);
+    long in_flight = atomic_load_explicit(&pool->in_flight, memory_order_relaxed);
+    out->submitted = out->executed + out->helped + (uint64_t)(in_flight > 0 ? in_flight : 0);
+}
+
+void thread_pool_shutdown(struct ThreadPool *pool)
+{
+    /**
+     * Stops accepting tasks, lets the workers finish every queued task and joins them.
+     *
+     * A task that slipped in while the workers were exiting is run by the caller, so
+     * every accepted task runs exactly once. Calling it again has no effect.
+     *
+     * @complexity Time complexity: O(w + n), where w is the number of workers and n the
+     *             number of queued tasks.
+     *
+     * @param pool Pointer to the ThreadPool structure.
+     */
+    if (!pool || pool->joined)
+    {
+        return;
+    }
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->stopping, true);
+    pthread_cond_broadcast(&pool->work_available);
+    pthread_mutex_unlock(&pool->lock);
+    for (int i = 0; i < pool->worker_count; i++)
+    {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+    pool->joined = true;
+    while (thread_pool_help(pool))
+    {
+    }
+#if DEBUG_MODE
+    fprintf(stderr, "INFO: Thread pool stopped %d workers.\n", pool->worker_count);
+#endif
+}
+
+void thread_pool_free(struct ThreadPool *pool)
+{
+    /**
+     * Shuts the pool down if it is still running and frees it.
+     *
+     * @complexity Time complexity: O(w + c), where w is the number of workers and c the
+     *             capacity.
+     *
+     * @param pool Pointer to the ThreadPool structure.
+     */
+    if (!pool)
+    {
+        fprintf(stderr, "INFO: Thread pool is already NULL. Skipping free.\n");
+        return;
+    }
+    thread_pool_shutdown(pool);
+    if (pool->workers && pool->tasks && pool->queue && pool->free_slots)
+    {
+        pthread_mutex_destroy(&pool->lock);
+        pthread_cond_destroy(&pool->work_available);
+        pthread_cond_destroy(&pool->all_done);
+    }
+    if (pool->queue)
+    {
+        pool->ops->destroy(pool->queue);
+    }
+    if (pool->free_slots)
+    {
+        elim_stack_free(pool->free_slots);
+    }
+    free(pool->tasks);
+    free(pool->workers);
+    free(pool);
+}
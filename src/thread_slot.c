@@ -0,0 +1,101 @@
+#include <stdatomic.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "thread_slot.h"
+
+#define THREAD_SLOT_WORDS ((QUEUE_MAX_THREADS + 63) / 64)
+
+static _Atomic uint64_t slot_bitmap[THREAD_SLOT_WORDS];
+static atomic_int slot_limit = 0;
+static _Thread_local int local_slot = -1;
+static pthread_key_t slot_key;
+static pthread_once_t slot_key_once = PTHREAD_ONCE_INIT;
+
+static void thread_slot_release(void *arg)
+{
+    /**
+     * Returns the slot of a terminating thread to the free pool.
+     *
+     * Registered as the destructor of `slot_key`, so slots are recycled automatically
+     * and a process can create any number of threads over its lifetime as long as at
+     * most `QUEUE_MAX_THREADS` of them use slots at the same time.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @param arg Slot index plus one, stored as a pointer.
+     */
+    int slot = (int)(intptr_t)arg - 1;
+    atomic_fetch_and(&slot_bitmap[slot / 64], ~(1ULL << (slot % 64)));
+    local_slot = -1;
+}
+
+static void thread_slot_create_key(void)
+{
+    /**
+     * Creates the thread-specific key used to release slots at thread exit.
+     *
+     * @complexity Time complexity: O(1).
+     */
+    pthread_key_create(&slot_key, thread_slot_release);
+}
+
+int queue_thread_slot(void)
+{
+    /**
+     * Returns a small integer that identifies the calling thread among live threads.
+     *
+     * Concurrent structures use the slot to index per-thread records (publication slots,
+     * counters) in plain arrays instead of searching a list. The lowest free slot is
+     * assigned on first use and kept until the thread exits.
+     *
+     * @complexity Time complexity: O(1) after the first call, O(QUEUE_MAX_THREADS / 64)
+     *             on the first call.
+     *
+     * @return The slot index in `[0, QUEUE_MAX_THREADS)`, or -1 if every slot is taken.
+     */
+    if (local_slot >= 0)
+    {
+        return local_slot;
+    }
+    pthread_once(&slot_key_once, thread_slot_create_key);
+
+    for (int word = 0; word < THREAD_SLOT_WORDS; word++)
+    {
+        uint64_t bits = atomic_load(&slot_bitmap[word]);
+        while (~bits != 0)
+        {
+            int bit = __builtin_ctzll(~bits);
+            int slot = word * 64 + bit;
+            if (slot >= QUEUE_MAX_THREADS)
+            {
+                break;
+            }
+            if (atomic_compare_exchange_weak(&slot_bitmap[word], &bits, bits | (1ULL << bit)))
+            {
+                int limit = atomic_load(&slot_limit);
+                while (limit <= slot && !atomic_compare_exchange_weak(&slot_limit, &limit, slot + 1))
+                {
+                }
+                local_slot = slot;
+                pthread_setspecific(slot_key, (void *)(intptr_t)(slot + 1));
+                return slot;
+            }
+        }
+    }
+    fprintf(stderr, "ERROR: Cannot assign a slot to more than %d threads.\n", QUEUE_MAX_THREADS);
+    return -1;
+}
+
+int queue_thread_slot_limit(void)
+{
+    /**
+     * Returns one past the highest slot ever assigned.
+     *
+     * Structures that scan per-thread records only need to visit slots below this limit.
+     *
+     * @complexity Time complexity: O(1).
+     *
+     * @return The number of slots that may be in use, in `[0, QUEUE_MAX_THREADS]`.
+     */
+    return atomic_load(&slot_limit);
+}